@@ -0,0 +1,95 @@
+/**
+ * @file cache_isolation_bench.cpp
+ * @brief Host benchmark: two-thread SPSC throughput with and without STREAM_ISOLATE_CACHE_LINES.
+ *
+ * One producer thread pushes into a BUFFER_RING_FULL RX buffer while one consumer thread pops.
+ * STREAM_ISOLATE_CACHE_LINES changes the Stream layout, so build the program twice and compare:
+ *
+ *   g++ -std=c++17 -O2 -pthread -Isrc -DSTREAM_ISOLATE_CACHE_LINES=0 bench/cache_isolation_bench.cpp src/Stream.cpp -o cache_packed
+ *   g++ -std=c++17 -O2 -pthread -Isrc -DSTREAM_ISOLATE_CACHE_LINES=1 bench/cache_isolation_bench.cpp src/Stream.cpp -o cache_isolated
+ *   ./cache_packed 0 1 && ./cache_isolated 0 1
+ *
+ * The optional arguments pin the producer and the consumer to the given CPUs (Linux), so the
+ * same and different cores, or sibling hyper-threads, can be compared. With a single core the
+ * threads only time-share and both layouts give the same figure.
+ */
+
+#include "Stream.h"
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+
+#if defined(__linux__)
+    #include <pthread.h>
+#endif
+
+static const uint32_t BYTES_PER_SIZE = 32u * 1024u * 1024u;
+
+static void pinToCpu(std::thread& thread, int cpu)
+{
+    #if defined(__linux__)
+        if (cpu < 0) return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) != 0)
+            printf("could not pin to CPU %d\n", cpu);
+    #else
+        (void)thread;
+        (void)cpu;
+    #endif
+}
+
+static double run(uint32_t chunk, int producerCpu, int consumerCpu)
+{
+    static char buffer[4096];
+    static Stream stream;   // static: over-aligned with STREAM_ISOLATE_CACHE_LINES
+    stream.setRxBuffer(buffer, sizeof(buffer), BUFFER_RING_FULL);
+
+    const uint32_t rounds = BYTES_PER_SIZE / chunk;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([chunk, rounds]()
+    {
+        char data[256];
+        std::memset(data, 'p', sizeof(data));
+        for (uint32_t i = 0; i < rounds; )
+        {
+            if (stream.pushBackRxBuffer(data, chunk)) ++i;
+            else std::this_thread::yield();     // full
+        }
+    });
+
+    std::thread consumer([chunk, rounds]()
+    {
+        char data[256];
+        for (uint32_t i = 0; i < rounds; )
+        {
+            if (stream.availableRx() >= chunk && stream.popFrontRxBuffer(data, chunk)) ++i;
+            else std::this_thread::yield();     // empty
+        }
+    });
+
+    pinToCpu(producer, producerCpu);
+    pinToCpu(consumer, consumerCpu);
+    producer.join();
+    consumer.join();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(rounds) * chunk / seconds / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+    const int producerCpu = (argc > 1) ? std::atoi(argv[1]) : -1;
+    const int consumerCpu = (argc > 2) ? std::atoi(argv[2]) : -1;
+
+    printf("STREAM_ISOLATE_CACHE_LINES=%d, sizeof(Stream)=%u, producer CPU %d, consumer CPU %d\n",
+           STREAM_ISOLATE_CACHE_LINES, static_cast<unsigned>(sizeof(Stream)), producerCpu, consumerCpu);
+
+    const uint32_t chunks[] = { 1, 16, 64, 256 };
+    printf("%10s %12s\n", "chunk", "MB/s");
+    for (uint32_t chunk : chunks)
+        printf("%10u %12.1f\n", chunk, run(chunk, producerCpu, consumerCpu));
+    return 0;
+}
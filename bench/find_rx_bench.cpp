@@ -0,0 +1,70 @@
+/**
+ * @file find_rx_bench.cpp
+ * @brief Host benchmark: findRx() segment scan against the previous byte-by-byte peekRx() loop.
+ *
+ * A 4 KB RX ring holds 4000 bytes that wrap the buffer end and contain no delimiter, so every
+ * scan reads all of them. findRx() searches the two contiguous segments with memchr; the
+ * reference loop is the previous implementation (one peekRx() call per byte).
+ * Results are in ns per scan and bytes per ns (multiply by the clock in GHz for bytes/cycle).
+ *
+ * Build and run (from the repository root):
+ *   g++ -std=c++17 -O2 -Isrc bench/find_rx_bench.cpp src/Stream.cpp -o find_rx_bench
+ *   ./find_rx_bench
+ */
+
+#include "Stream.h"
+#include <chrono>
+
+static const uint32_t BUFFER_SIZE = 4096;
+static const uint32_t SCAN_BYTES = 4000;
+
+/// @brief findRx() as it was before the segment scan: one peekRx() per byte.
+static size_t findRxPerByte(const Stream& stream, char delimiter)
+{
+    const uint32_t avail = stream.availableRx();
+    for (size_t i = 0; i < avail; ++i)
+    {
+        if (stream.peekRx(i) == delimiter) return i;
+    }
+    return SIZE_MAX;
+}
+
+template <typename Find>
+static double nsPerScan(const Stream& stream, uint32_t scans, Find find, size_t& sink)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < scans; ++i) sink += find(stream);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / scans;
+}
+
+static void run(BufferType type, const char* name, size_t& sink)
+{
+    static char buffer[BUFFER_SIZE];
+    static char fill[SCAN_BYTES];
+    std::memset(fill, 'a', sizeof(fill));
+
+    Stream stream;
+    stream.setRxBuffer(buffer, BUFFER_SIZE, type);
+
+    // Move the read position to the middle so the data wraps the buffer end
+    char skip[BUFFER_SIZE / 2];
+    stream.pushBackRxBuffer(fill, sizeof(skip));
+    stream.popFrontRxBuffer(skip, sizeof(skip));
+    stream.pushBackRxBuffer(fill, SCAN_BYTES);
+
+    const double perByte = nsPerScan(stream, 2000, [](const Stream& s) { return findRxPerByte(s, '\n'); }, sink);
+    const double segment = nsPerScan(stream, 200000, [](const Stream& s) { return s.findRx('\n'); }, sink);
+
+    printf("%-10s %-16s %12.1f %10.2f\n", name, "peekRx loop", perByte, SCAN_BYTES / perByte);
+    printf("%-10s %-16s %12.1f %10.2f\n", name, "findRx", segment, SCAN_BYTES / segment);
+}
+
+int main()
+{
+    size_t sink = 0;
+    printf("%-10s %-16s %12s %10s\n", "mode", "search", "ns/scan", "B/ns");
+    run(BUFFER_RING, "RING", sink);
+    run(BUFFER_RING_POW2, "RING_POW2", sink);
+    printf("(checksum %zu)\n", sink & 0xFF);
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file mpsc_bench.cpp
+ * @brief Host benchmark: BUFFER_RING_MPSC throughput with 1..8 producer threads and one consumer.
+ *
+ * Each producer pushes fixed-size messages with pushBackTxBuffer() (retrying while the ring is
+ * full); the consumer drains with txPeekContiguous()/removeFrontTxBuffer(). The single-producer
+ * BUFFER_RING_FULL figure is the baseline the multi-producer claim/publish costs compare against.
+ * Results depend on the core count: on one core the threads only time-share.
+ *
+ * Build and run (from the repository root):
+ *   g++ -std=c++17 -O2 -pthread -Isrc bench/mpsc_bench.cpp src/Stream.cpp -o mpsc_bench
+ *   ./mpsc_bench
+ */
+
+#include "Stream.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+static const uint32_t BYTES_PER_RUN = 64u * 1024u * 1024u;
+
+static double run(BufferType type, uint32_t producers, uint32_t messageSize)
+{
+    static char buffer[8192];
+    Stream stream;
+    stream.setTxBuffer(buffer, sizeof(buffer), type);
+
+    const uint32_t perProducer = BYTES_PER_RUN / messageSize / producers;
+    const uint32_t total = perProducer * producers * messageSize;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&stream, perProducer, messageSize]()
+        {
+            char msg[256];
+            std::memset(msg, 'x', sizeof(msg));
+            for (uint32_t i = 0; i < perProducer; )
+            {
+                if (stream.pushBackTxBuffer(msg, messageSize)) ++i;
+                else std::this_thread::yield();
+            }
+        });
+    }
+
+    uint32_t received = 0;
+    while (received < total)
+    {
+        const char* ptr;
+        uint32_t len;
+        if (!stream.txPeekContiguous(ptr, len) || len == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        stream.removeFrontTxBuffer(len);
+        received += len;
+    }
+
+    for (std::thread& t : threads) t.join();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total / seconds / 1e6;
+}
+
+int main()
+{
+    const uint32_t sizes[] = { 16, 64, 256 };
+
+    printf("%-22s %9s %12s\n", "mode", "msg size", "MB/s");
+    for (uint32_t size : sizes)
+    {
+        printf("%-22s %9u %12.1f\n", "RING_FULL, 1 producer", size, run(BUFFER_RING_FULL, 1, size));
+        for (uint32_t producers = 1; producers <= 8; ++producers)
+        {
+            char label[32];
+            snprintf(label, sizeof(label), "RING_MPSC, %u prod.", producers);
+            printf("%-22s %9u %12.1f\n", label, size, run(BUFFER_RING_MPSC, producers, size));
+        }
+    }
+    return 0;
+}
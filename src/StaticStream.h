@@ -0,0 +1,654 @@
+#pragma once
+
+/**
+ * @file StaticStream.h
+ * @brief Header-only, compile-time specialized TX/RX buffer manager.
+ *
+ * StaticStream<TxN, RxN, TxPolicy, RxPolicy> offers the same API as Stream, but:
+ * - It owns its TX/RX storage (no user buffers, no null/size checks at runtime).
+ * - Buffer sizes, capacity and index masks are compile-time constants.
+ * - Indexing (linear/ring) and overflow behavior are chosen by template policy,
+ *   so the hot path has no runtime buffer-type branches.
+ *
+ * Policies:
+ * - StaticRingPolicy<DropOldest = false>:
+ *   Same behavior as BUFFER_RING_FULL (free-running head/tail counters, capacity N).
+ *   N must be a power of two.
+ * - StaticLinearPolicy<DropOldest = true>:
+ *   Same behavior as BUFFER_LINEAR (data at index 0, '\0' terminated, capacity N - 1).
+ *
+ * @warning Ring policy with DropOldest = true moves the consumer index from the producer.
+ *          Only use it when producer and consumer cannot run concurrently.
+ *
+ * Example:
+ * @code
+ * StaticStream<256, 512, StaticRingPolicy<>, StaticRingPolicy<>> uart;
+ * @endcode
+ */
+
+// ####################################################################################################
+// Include libraries:
+
+#include "Stream.h"
+
+// ###################################################################################################
+// Policies
+
+/**
+ * @struct StaticRingPolicy
+ * @brief Ring indexing with free-running counters (power-of-two size, capacity = N).
+ * @tparam DropOldest If true, a push that does not fit evicts the oldest bytes; otherwise it is rejected.
+ */
+template <bool DropOldest = false>
+struct StaticRingPolicy
+{
+    static constexpr bool isRing() { return true; }
+    static constexpr bool dropOldest() { return DropOldest; }
+};
+
+/**
+ * @struct StaticLinearPolicy
+ * @brief Linear indexing, data always at index 0 ('\0' terminated, capacity = N - 1).
+ * @tparam DropOldest If true, a push that does not fit evicts the oldest bytes; otherwise it is rejected.
+ */
+template <bool DropOldest = true>
+struct StaticLinearPolicy
+{
+    static constexpr bool isRing() { return false; }
+    static constexpr bool dropOldest() { return DropOldest; }
+};
+
+// ###################################################################################################
+// StaticStreamBuffer class
+
+/**
+ * @class StaticStreamBuffer
+ * @brief One direction (TX or RX) of a StaticStream.
+ * @tparam N Buffer size in bytes.
+ * @tparam Policy StaticRingPolicy<> or StaticLinearPolicy<>.
+ *
+ * Ring state follows the Stream single-producer/single-consumer rules:
+ * head is written by the producer only, tail by the consumer only.
+ */
+template <uint32_t N, class Policy>
+class StaticStreamBuffer
+{
+    static_assert(N >= 2, "StaticStreamBuffer: size must be >= 2");
+    static_assert(!Policy::isRing() || ((N & (N - 1)) == 0), "StaticStreamBuffer: ring size must be a power of two");
+
+public:
+
+    /// @brief Buffer size in bytes.
+    static constexpr uint32_t size() { return N; }
+
+    /// @brief Effective capacity (N for ring, N - 1 for linear).
+    static constexpr uint32_t capacity() { return Policy::isRing() ? N : (N - 1); }
+
+    /// @brief Ring index mask.
+    static constexpr uint32_t mask() { return N - 1; }
+
+    /// @brief Equivalent Stream buffer type.
+    static constexpr BufferType type() { return Policy::isRing() ? BUFFER_RING_FULL : BUFFER_LINEAR; }
+
+    StaticStreamBuffer() { clear(); }
+
+    StaticStreamBuffer(const StaticStreamBuffer&) = delete;
+    StaticStreamBuffer& operator=(const StaticStreamBuffer&) = delete;
+
+    const char* base() const { return _buffer; }
+
+    void clear()
+    {
+        std::memset(_buffer, 0, N);
+        _head = 0;
+        _tail = 0;
+    }
+
+    uint32_t available() const
+    {
+        if (Policy::isRing()) return streamLoadAcquire(_head) - streamLoadAcquire(_tail);
+        return streamLoadAcquire(_head);
+    }
+
+    uint32_t free() const { return capacity() - available(); }
+
+    const char* readPtr() const
+    {
+        if (Policy::isRing()) return &_buffer[streamLoadAcquire(_tail) & mask()];
+        return _buffer;
+    }
+
+    void peekContiguous(const char*& ptr, uint32_t& len) const
+    {
+        const uint32_t tail = streamLoadAcquire(_tail);
+        const uint32_t head = streamLoadAcquire(_head);
+
+        if (Policy::isRing())
+        {
+            const uint32_t used = head - tail;
+            const uint32_t toEnd = N - (tail & mask());
+            len = (used < toEnd) ? used : toEnd;
+            ptr = (len == 0) ? nullptr : &_buffer[tail & mask()];
+            return;
+        }
+
+        len = head;
+        ptr = _buffer;
+    }
+
+    void peek(const char*& seg1, uint32_t& len1, const char*& seg2, uint32_t& len2) const
+    {
+        seg1 = seg2 = nullptr;
+        len1 = len2 = 0;
+
+        const uint32_t tail = streamLoadAcquire(_tail);
+        const uint32_t head = streamLoadAcquire(_head);
+        const uint32_t used = Policy::isRing() ? (head - tail) : head;
+        if (used == 0) return;
+
+        const uint32_t index = Policy::isRing() ? (tail & mask()) : 0;
+        const uint32_t toEnd = N - index;
+
+        seg1 = &_buffer[index];
+        len1 = (used < toEnd) ? used : toEnd;
+        if (used > len1)
+        {
+            seg2 = &_buffer[0];
+            len2 = used - len1;
+        }
+    }
+
+    char peekAt(size_t index) const
+    {
+        if (index >= available()) return 0;
+        if (Policy::isRing()) return _buffer[(streamLoadAcquire(_tail) + static_cast<uint32_t>(index)) & mask()];
+        return _buffer[index];
+    }
+
+    /**
+     * @brief Push data, applying the policy overflow rule.
+     * @return StreamError code.
+     */
+    int8_t push(const char* data, uint32_t dataSize)
+    {
+        int8_t err = STREAM_OK;
+
+        if (dataSize > capacity())
+        {
+            data += (dataSize - capacity());
+            dataSize = capacity();
+            err = STREAM_ERR_OVERFLOW_OR_SHORT;
+            if (!Policy::dropOldest()) return err;
+        }
+
+        const uint32_t freeSpace = free();
+        if (dataSize > freeSpace)
+        {
+            err = STREAM_ERR_OVERFLOW_OR_SHORT;
+            if (!Policy::dropOldest()) return err;
+            drop(dataSize - freeSpace);
+        }
+
+        if (Policy::isRing())
+        {
+            const uint32_t head = _head;
+            const uint32_t index = head & mask();
+            const uint32_t toEnd = N - index;
+            const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
+
+            std::memcpy(&_buffer[index], data, first);
+            if (dataSize > first)
+                std::memcpy(&_buffer[0], data + first, dataSize - first);
+
+            streamStoreRelease(_head, head + dataSize);
+            return err;
+        }
+
+        // Linear: explicit load and release store (no read-modify-write on the atomic backend)
+        const uint32_t head = _head;
+        std::memcpy(&_buffer[head], data, dataSize);
+        _buffer[head + dataSize] = '\0';
+        streamStoreRelease(_head, head + dataSize);
+        return err;
+    }
+
+    /**
+     * @brief Pop up to dataSize bytes into data.
+     * @return Number of bytes copied.
+     */
+    uint32_t pop(char* data, uint32_t dataSize)
+    {
+        const uint32_t avail = available();
+        if (dataSize > avail) dataSize = avail;
+        if (dataSize == 0) return 0;
+
+        if (Policy::isRing())
+        {
+            const uint32_t tail = _tail;
+            const uint32_t index = tail & mask();
+            const uint32_t toEnd = N - index;
+            const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
+
+            std::memcpy(data, &_buffer[index], first);
+            if (dataSize > first)
+                std::memcpy(data + first, &_buffer[0], dataSize - first);
+
+            streamStoreRelease(_tail, tail + dataSize);
+            return dataSize;
+        }
+
+        std::memcpy(data, _buffer, dataSize);
+        drop(dataSize);
+        return dataSize;
+    }
+
+    /// @brief Remove dataSize bytes from the front (dataSize <= available()).
+    void drop(uint32_t dataSize)
+    {
+        if (Policy::isRing())
+        {
+            const uint32_t tail = _tail;
+            streamStoreRelease(_tail, tail + dataSize);
+            return;
+        }
+
+        const uint32_t head = _head;
+        std::memmove(_buffer, _buffer + dataSize, head - dataSize);
+        _buffer[head - dataSize] = '\0';
+        streamStoreRelease(_head, head - dataSize);
+    }
+
+    uint32_t reserve(uint32_t dataSize, char*& seg1, uint32_t& len1, char*& seg2, uint32_t& len2)
+    {
+        seg1 = seg2 = nullptr;
+        len1 = len2 = 0;
+
+        const uint32_t freeSpace = free();
+        if (dataSize > freeSpace) dataSize = freeSpace;
+        if (dataSize == 0) return 0;
+
+        const uint32_t head = _head;
+        const uint32_t index = Policy::isRing() ? (head & mask()) : head;
+        const uint32_t toEnd = N - index;
+
+        seg1 = &_buffer[index];
+        len1 = (dataSize < toEnd) ? dataSize : toEnd;
+        if (dataSize > len1)
+        {
+            seg2 = &_buffer[0];
+            len2 = dataSize - len1;
+        }
+        return dataSize;
+    }
+
+    void commit(uint32_t dataSize)
+    {
+        const uint32_t head = _head;
+        if (!Policy::isRing()) _buffer[head + dataSize] = '\0';
+        streamStoreRelease(_head, head + dataSize);
+    }
+
+private:
+
+    char _buffer[N];
+
+    // Ring: free-running counters. Linear: _head is the data length, _tail is unused.
+    STREAM_CACHE_ALIGN StreamIndex _head;    ///< written by producer only (own cache line with STREAM_ISOLATE_CACHE_LINES)
+    STREAM_CACHE_ALIGN StreamIndex _tail;    ///< written by consumer only
+};
+
+// ######################################################################################################
+// StaticStream class
+
+/**
+ * @class StaticStream
+ * @brief Compile-time specialized Stream that owns its TX/RX storage.
+ * @tparam TxN TX buffer size in bytes.
+ * @tparam RxN RX buffer size in bytes.
+ * @tparam TxPolicy TX indexing/overflow policy.
+ * @tparam RxPolicy RX indexing/overflow policy.
+ *
+ * StaticStream implements a subset of Stream. The functions below behave and set error codes
+ * as their Stream counterparts (see @ref StreamError):
+ * - Buffer info: getTx/RxBufferType(), getTx/RxBufferSize(), getTx/RxBuffer(), freeTx/Rx(), availableTx/Rx().
+ * - Zero-copy access: txReadPtr(), rxReadPtr(), txContiguousSize(), txPeekContiguous(), rxPeek(),
+ *   rxConsume(), rxContiguousSize(), reserveTx()/commitTx(), reserveRx()/commitRx().
+ * - Copy access: writeTx/RxBuffer(), pushBackTx/RxBuffer(), popFrontTx/RxBuffer(), popAllTx/RxBuffer()
+ *   (std::string overloads on _PLATFORM_PC_), removeFrontTx/RxBuffer(), clearTx/RxBuffer(), compactTx/RxBuffer().
+ * - RX search: peekRx(), findRx(char), copyRxUntil().
+ *
+ * Not provided:
+ * - setTxBuffer(), setRxBuffer(), setBufferTypes(): storage and mode are template parameters.
+ * - Modes other than BUFFER_LINEAR (StaticLinearPolicy) and BUFFER_RING_FULL (StaticRingPolicy).
+ * - Runtime overflow policies and drop statistics (set/getTx/RxOverflowPolicy(), get*Dropped*(),
+ *   get*DropEvents(), reset*DropStats(), get*LastPushSize()). Overflow is REJECT or DROP_OLDEST,
+ *   chosen by the policy's DropOldest parameter.
+ * - Scatter/gather: pushBackTx/RxBufferV(), popFrontTx/RxBufferV(), Stream::splice().
+ * - findRx(pattern, size), findRxFrom(), readLineRx(), consumeLineRx(), drainLinesRx().
+ * - RX readers (attachRxReader() and friends) and the wait functions (waitRxAvailable(), ...).
+ * - StreamFraming encoders/decoders, which take a Stream&.
+ */
+template <uint32_t TxN, uint32_t RxN, class TxPolicy = StaticRingPolicy<>, class RxPolicy = StaticRingPolicy<>>
+class StaticStream
+{
+public:
+
+    /** @brief Last error code (see @ref StreamError). */
+    int8_t errorCode = STREAM_OK;
+
+    StaticStream() = default;
+
+    StaticStream(const StaticStream&) = delete;
+    StaticStream& operator=(const StaticStream&) = delete;
+    StaticStream(StaticStream&&) = delete;
+    StaticStream& operator=(StaticStream&&) = delete;
+
+    /// @copydoc Stream::getTxBufferType()
+    static constexpr BufferType getTxBufferType() { return StaticStreamBuffer<TxN, TxPolicy>::type(); }
+
+    /// @copydoc Stream::getRxBufferType()
+    static constexpr BufferType getRxBufferType() { return StaticStreamBuffer<RxN, RxPolicy>::type(); }
+
+    /// @copydoc Stream::getTxBufferSize()
+    static constexpr uint32_t getTxBufferSize() { return TxN; }
+
+    /// @copydoc Stream::getRxBufferSize()
+    static constexpr uint32_t getRxBufferSize() { return RxN; }
+
+    /// @copydoc Stream::getTxBuffer()
+    const char* getTxBuffer() const { return _tx.base(); }
+
+    /// @copydoc Stream::getRxBuffer()
+    const char* getRxBuffer() const { return _rx.base(); }
+
+    /// @copydoc Stream::txReadPtr()
+    const char* txReadPtr() const { return _tx.readPtr(); }
+
+    /// @copydoc Stream::rxReadPtr()
+    const char* rxReadPtr() const { return _rx.readPtr(); }
+
+    /// @copydoc Stream::txContiguousSize()
+    uint32_t txContiguousSize() const
+    {
+        const char* ptr;
+        uint32_t len;
+        _tx.peekContiguous(ptr, len);
+        return len;
+    }
+
+    /// @copydoc Stream::txPeekContiguous()
+    bool txPeekContiguous(const char*& ptr, uint32_t& len) const
+    {
+        _tx.peekContiguous(ptr, len);
+        return true;
+    }
+
+    /// @copydoc Stream::rxPeek()
+    bool rxPeek(const char*& seg1, uint32_t& len1, const char*& seg2, uint32_t& len2) const
+    {
+        _rx.peek(seg1, len1, seg2, len2);
+        return true;
+    }
+
+    /// @copydoc Stream::rxConsume()
+    bool rxConsume(uint32_t dataSize) { return removeFrontRxBuffer(dataSize); }
+
+    /// @copydoc Stream::rxContiguousSize()
+    uint32_t rxContiguousSize() const
+    {
+        const char* ptr;
+        uint32_t len;
+        _rx.peekContiguous(ptr, len);
+        return len;
+    }
+
+    /// @copydoc Stream::freeTx()
+    uint32_t freeTx() const { return _tx.free(); }
+
+    /// @copydoc Stream::freeRx()
+    uint32_t freeRx() const { return _rx.free(); }
+
+    /// @copydoc Stream::clearTxBuffer()
+    void clearTxBuffer() { errorCode = STREAM_OK; _tx.clear(); }
+
+    /// @copydoc Stream::clearRxBuffer()
+    void clearRxBuffer() { errorCode = STREAM_OK; _rx.clear(); }
+
+    /// @copydoc Stream::compactTxBuffer()
+    const char* compactTxBuffer()
+    {
+        errorCode = STREAM_OK;
+        if (TxPolicy::isRing()) { errorCode = STREAM_ERR_PARAM; return nullptr; }
+        return _tx.base();
+    }
+
+    /// @copydoc Stream::compactRxBuffer()
+    const char* compactRxBuffer()
+    {
+        errorCode = STREAM_OK;
+        if (RxPolicy::isRing()) { errorCode = STREAM_ERR_PARAM; return nullptr; }
+        return _rx.base();
+    }
+
+    /// @copydoc Stream::removeFrontTxBuffer()
+    bool removeFrontTxBuffer(uint32_t dataSize = 1)
+    {
+        errorCode = STREAM_OK;
+        if (dataSize == 0) return true;
+        if (dataSize > _tx.available()) { errorCode = STREAM_ERR_PARAM; return false; }
+        _tx.drop(dataSize);
+        return true;
+    }
+
+    /// @copydoc Stream::removeFrontRxBuffer()
+    bool removeFrontRxBuffer(uint32_t dataSize = 1)
+    {
+        errorCode = STREAM_OK;
+        if (dataSize == 0) return true;
+        if (dataSize > _rx.available()) { errorCode = STREAM_ERR_PARAM; return false; }
+        _rx.drop(dataSize);
+        return true;
+    }
+
+    /// @copydoc Stream::writeTxBuffer()
+    bool writeTxBuffer(const char* data, uint32_t dataSize)
+    {
+        errorCode = STREAM_OK;
+        if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+        if (data == nullptr || dataSize > _tx.capacity()) { errorCode = STREAM_ERR_PARAM; return false; }
+        clearTxBuffer();
+        return pushBackTxBuffer(data, dataSize);
+    }
+
+    /// @copydoc Stream::writeRxBuffer()
+    bool writeRxBuffer(const char* data, uint32_t dataSize)
+    {
+        errorCode = STREAM_OK;
+        if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+        if (data == nullptr || dataSize > _rx.capacity()) { errorCode = STREAM_ERR_PARAM; return false; }
+        clearRxBuffer();
+        return pushBackRxBuffer(data, dataSize);
+    }
+
+    /// @copydoc Stream::pushBackTxBuffer(const char*, uint32_t)
+    bool pushBackTxBuffer(const char* data, uint32_t dataSize = 1)
+    {
+        errorCode = STREAM_OK;
+        if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+        if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+        errorCode = _tx.push(data, dataSize);
+        return errorCode == STREAM_OK;
+    }
+
+    /// @copydoc Stream::pushBackRxBuffer(const char*, uint32_t)
+    bool pushBackRxBuffer(const char* data, uint32_t dataSize = 1)
+    {
+        errorCode = STREAM_OK;
+        if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+        if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+        errorCode = _rx.push(data, dataSize);
+        return errorCode == STREAM_OK;
+    }
+
+    /// @copydoc Stream::popFrontTxBuffer(char*, uint32_t)
+    bool popFrontTxBuffer(char* data, uint32_t dataSize = 1)
+    {
+        errorCode = STREAM_OK;
+        if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+        if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+        if (_tx.pop(data, dataSize) != dataSize) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+        return true;
+    }
+
+    /// @copydoc Stream::popFrontRxBuffer(char*, uint32_t)
+    bool popFrontRxBuffer(char* data, uint32_t dataSize = 1)
+    {
+        errorCode = STREAM_OK;
+        if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+        if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+        if (_rx.pop(data, dataSize) != dataSize) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+        return true;
+    }
+
+    /// @copydoc Stream::popAllTxBuffer(char*, uint32_t)
+    bool popAllTxBuffer(char* data, uint32_t maxSize) { return popFrontTxBuffer(data, maxSize); }
+
+    /// @copydoc Stream::popAllRxBuffer(char*, uint32_t)
+    bool popAllRxBuffer(char* data, uint32_t maxSize) { return popFrontRxBuffer(data, maxSize); }
+
+    #if defined(_PLATFORM_PC_)
+        /// @copydoc Stream::pushBackTxBuffer(const std::string&)
+        bool pushBackTxBuffer(const std::string& data) { return pushBackTxBuffer(data.c_str(), data.size()); }
+
+        /// @copydoc Stream::pushBackRxBuffer(const std::string&)
+        bool pushBackRxBuffer(const std::string& data) { return pushBackRxBuffer(data.c_str(), data.size()); }
+
+        /// @copydoc Stream::popFrontTxBuffer(std::string&, uint32_t)
+        bool popFrontTxBuffer(std::string& out, uint32_t dataSize = 1)
+        {
+            out.clear();
+            if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+            errorCode = STREAM_OK;
+            out.resize(dataSize);
+            const uint32_t got = _tx.pop(&out[0], dataSize);
+            out.resize(got);
+            if (got != dataSize) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+            return true;
+        }
+
+        /// @copydoc Stream::popFrontRxBuffer(std::string&, uint32_t)
+        bool popFrontRxBuffer(std::string& out, uint32_t dataSize = 1)
+        {
+            out.clear();
+            if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+            errorCode = STREAM_OK;
+            out.resize(dataSize);
+            const uint32_t got = _rx.pop(&out[0], dataSize);
+            out.resize(got);
+            if (got != dataSize) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+            return true;
+        }
+
+        /// @copydoc Stream::popAllTxBuffer(std::string&)
+        bool popAllTxBuffer(std::string& data) { return popFrontTxBuffer(data, availableTx()); }
+
+        /// @copydoc Stream::popAllRxBuffer(std::string&)
+        bool popAllRxBuffer(std::string& data) { return popFrontRxBuffer(data, availableRx()); }
+    #endif
+
+    /// @copydoc Stream::availableTx()
+    uint32_t availableTx() const { return _tx.available(); }
+
+    /// @copydoc Stream::availableRx()
+    uint32_t availableRx() const { return _rx.available(); }
+
+    /// @copydoc Stream::peekRx()
+    char peekRx(size_t index) const { return _rx.peekAt(index); }
+
+    /// @copydoc Stream::findRx()
+    size_t findRx(char delimiter) const
+    {
+        const char *seg1, *seg2;
+        uint32_t len1, len2;
+        _rx.peek(seg1, len1, seg2, len2);
+
+        const void* hit = len1 ? std::memchr(seg1, delimiter, len1) : nullptr;
+        if (hit) return static_cast<size_t>(static_cast<const char*>(hit) - seg1);
+
+        hit = len2 ? std::memchr(seg2, delimiter, len2) : nullptr;
+        if (hit) return len1 + static_cast<size_t>(static_cast<const char*>(hit) - seg2);
+
+        return SIZE_MAX;
+    }
+
+    /// @copydoc Stream::copyRxUntil()
+    size_t copyRxUntil(char delimiter, char* dst, size_t dstSize) const
+    {
+        if (dst == nullptr || dstSize == 0)
+            return SIZE_MAX;
+
+        const char *seg1, *seg2;
+        uint32_t len1, len2;
+        _rx.peek(seg1, len1, seg2, len2);
+        if ((len1 + len2) == 0)
+        {
+            dst[0] = '\0';
+            return 0;
+        }
+
+        const size_t index = findRx(delimiter);
+        const size_t toCopy = (index == SIZE_MAX) ? (len1 + len2) : index;
+        const size_t limit = (toCopy < dstSize) ? toCopy : (dstSize - 1);
+
+        // Copy segment by segment instead of one peekAt() per byte
+        const size_t first = (limit < len1) ? limit : len1;
+        if (first) std::memcpy(dst, seg1, first);
+        if (limit > first) std::memcpy(dst + first, seg2, limit - first);
+        dst[limit] = '\0';
+
+        return (index == SIZE_MAX || toCopy >= dstSize) ? SIZE_MAX : index;
+    }
+
+    /// @copydoc Stream::reserveTx()
+    uint32_t reserveTx(uint32_t dataSize, char*& seg1, uint32_t& len1, char*& seg2, uint32_t& len2)
+    {
+        errorCode = STREAM_OK;
+        if (dataSize == 0) { seg1 = seg2 = nullptr; len1 = len2 = 0; errorCode = STREAM_ERR_SIZE_ZERO; return 0; }
+        const uint32_t reserved = _tx.reserve(dataSize, seg1, len1, seg2, len2);
+        if (reserved < dataSize) errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        return reserved;
+    }
+
+    /// @copydoc Stream::commitTx()
+    bool commitTx(uint32_t dataSize)
+    {
+        errorCode = STREAM_OK;
+        if (dataSize > _tx.free()) { errorCode = STREAM_ERR_PARAM; return false; }
+        if (dataSize) _tx.commit(dataSize);
+        return true;
+    }
+
+    /// @copydoc Stream::reserveRx()
+    uint32_t reserveRx(uint32_t dataSize, char*& seg1, uint32_t& len1, char*& seg2, uint32_t& len2)
+    {
+        errorCode = STREAM_OK;
+        if (dataSize == 0) { seg1 = seg2 = nullptr; len1 = len2 = 0; errorCode = STREAM_ERR_SIZE_ZERO; return 0; }
+        const uint32_t reserved = _rx.reserve(dataSize, seg1, len1, seg2, len2);
+        if (reserved < dataSize) errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        return reserved;
+    }
+
+    /// @copydoc Stream::commitRx()
+    bool commitRx(uint32_t dataSize)
+    {
+        errorCode = STREAM_OK;
+        if (dataSize > _rx.free()) { errorCode = STREAM_ERR_PARAM; return false; }
+        if (dataSize) _rx.commit(dataSize);
+        return true;
+    }
+
+private:
+
+    StaticStreamBuffer<TxN, TxPolicy> _tx;
+    StaticStreamBuffer<RxN, RxPolicy> _rx;
+};
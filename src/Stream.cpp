@@ -6,6 +6,16 @@
 #include <limits>
 #include <cstdlib>
 
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+#if defined(_PLATFORM_PC_)
+    #include <atomic>
+    #include <chrono>
+    #include <thread>
+#endif
+
 // #####################################################################################################
 // Public General functions
 
@@ -969,8 +979,8 @@ Stream::Stream(char* txBuffer, uint32_t txBufferSize, char* rxBuffer, uint32_t r
     _txPosition = 0;
     _rxPosition = 0;
 
-    _txType = txType;
-    _rxType = rxType;
+    bool typesOk = _applyTxType(txType);
+    typesOk = _applyRxType(rxType) && typesOk;
 
     _txHead = _txTail = 0;
     _rxHead = _rxTail = 0;
@@ -979,707 +989,2587 @@ Stream::Stream(char* txBuffer, uint32_t txBufferSize, char* rxBuffer, uint32_t r
     if (_txBuffer && _txBufferSize) memset(_txBuffer, 0, _txBufferSize);
     if (_rxBuffer && _rxBufferSize) memset(_rxBuffer, 0, _rxBufferSize);
 
-    errorCode = STREAM_OK;
+    errorCode = typesOk ? STREAM_OK : STREAM_ERR_PARAM;
 }
 
 void Stream::setTxBuffer(char* txBuffer, uint32_t txBufferSize, BufferType txType)
 {
     _txBufferSize = txBufferSize;
     _txBuffer = txBuffer;
-    _txType = txType;
+    bool typeOk = _applyTxType(txType);
     clearTxBuffer();
+    if (!typeOk) errorCode = STREAM_ERR_PARAM;
 }
 
 void Stream::setRxBuffer(char* rxBuffer, uint32_t rxBufferSize, BufferType rxType)
 {
     _rxBufferSize = rxBufferSize;
     _rxBuffer = rxBuffer;
-    _rxType = rxType;
+    bool typeOk = _applyRxType(rxType);
+    _detachAllRxReaders();
     clearRxBuffer();
+    if (!typeOk) errorCode = STREAM_ERR_PARAM;
 }
 
 void Stream::setBufferTypes(BufferType txType, BufferType rxType)
 {
-    _txType = txType;
-    _rxType = rxType;
+    bool typesOk = _applyTxType(txType);
+    typesOk = _applyRxType(rxType) && typesOk;
+    _detachAllRxReaders();
     clearTxBuffer();
     clearRxBuffer();
+    if (!typesOk) errorCode = STREAM_ERR_PARAM;
 }
 
-const char* Stream::getTxBuffer() const
+bool Stream::_isPowerOfTwo(uint32_t value)
 {
-    return _txBuffer;       // always base pointer
+    return (value != 0) && ((value & (value - 1)) == 0);
 }
 
-uint32_t Stream::getTxBufferSize() const
+bool Stream::_applyTxType(BufferType txType)
 {
-    return _txBufferSize;
-}
+    _txMask = 0;
 
-const char* Stream::getRxBuffer() const
-{
-    return _rxBuffer;       // always base pointer
-}
+#if !STREAM_ENABLE_MPSC
+    if (txType == BUFFER_RING_MPSC)
+    {
+        // Multi-producer support is compiled out; keep a single-producer ring with the same capacity if possible.
+        _txType = BUFFER_RING;
+        if (_isPowerOfTwo(_txBufferSize))
+        {
+            _txType = BUFFER_RING_FULL;
+            _txMask = _txBufferSize - 1;
+        }
+        return false;
+    }
+#endif
 
-const char* Stream::txReadPtr() const
-{
-    if (_txType == BUFFER_RING)
+    if ((txType == BUFFER_RING_POW2) || (txType == BUFFER_RING_FULL) || (txType == BUFFER_RING_MPSC))
     {
-        if (!_txBuffer || _txBufferSize < 2) return nullptr;
-        return &_txBuffer[_txTail];
+        if (!_isPowerOfTwo(_txBufferSize))
+        {
+            // Mask indexing is impossible: keep ring semantics with modulo indexing.
+            _txType = BUFFER_RING;
+            return false;
+        }
+        _txMask = _txBufferSize - 1;
     }
-    return _txBuffer;
+
+    _txType = txType;
+    return true;
 }
 
-const char* Stream::rxReadPtr() const
+bool Stream::_applyRxType(BufferType rxType)
 {
-    if (_rxType == BUFFER_RING)
+    _rxMask = 0;
+
+    if (rxType == BUFFER_RING_MPSC)
     {
-        if (!_rxBuffer || _rxBufferSize < 2) return nullptr;
-        return &_rxBuffer[_rxTail];
+        // Multi-producer mode is TX only; keep a single-producer ring with the same capacity if possible.
+        _rxType = BUFFER_RING;
+        if (_isPowerOfTwo(_rxBufferSize))
+        {
+            _rxType = BUFFER_RING_FULL;
+            _rxMask = _rxBufferSize - 1;
+        }
+        return false;
     }
-    return _rxBuffer;
+
+    if ((rxType == BUFFER_RING_POW2) || (rxType == BUFFER_RING_FULL))
+    {
+        if (!_isPowerOfTwo(_rxBufferSize))
+        {
+            _rxType = BUFFER_RING;
+            return false;
+        }
+        _rxMask = _rxBufferSize - 1;
+    }
+
+    _rxType = rxType;
+    return true;
 }
 
-uint32_t Stream::getRxBufferSize() const
+void Stream::_txSnapshot(uint32_t& head, uint32_t& tail) const
 {
-    return _rxBufferSize;
+#if STREAM_USE_STD_ATOMIC
+    tail = streamLoadAcquire(_txTail);
+    head = streamLoadAcquire(_txHead);
+#else
+    uint32_t tail2;
+    do
+    {
+        tail = _txTail;
+        head = _txHead;
+        tail2 = _txTail;
+    } while (tail != tail2);
+#endif
 }
 
-void Stream::clearTxBuffer() 
+void Stream::_rxSnapshot(uint32_t& head, uint32_t& tail) const
 {
-    errorCode = STREAM_OK;
-    if (_txBuffer && _txBufferSize) memset(_txBuffer, 0, _txBufferSize);    // Zero out TX buffers
-    
-    _txPosition = 0;
-    _txHead = _txTail = 0;
+#if STREAM_USE_STD_ATOMIC
+    tail = streamLoadAcquire(_rxTail);
+    head = streamLoadAcquire(_rxHead);
+#else
+    uint32_t tail2;
+    do
+    {
+        tail = _rxTail;
+        head = _rxHead;
+        tail2 = _rxTail;
+    } while (tail != tail2);
+#endif
 }
 
-void Stream::clearRxBuffer() 
+uint32_t Stream::_txRingFree(uint32_t dataSize)
 {
-    errorCode = STREAM_OK;
-    if (_rxBuffer && _rxBufferSize) memset(_rxBuffer, 0, _rxBufferSize);    // Zero out RX buffer
-    
-    _rxPosition = 0;
-    _rxHead = _rxTail = 0;
+    const uint32_t head = _txHead;
+    const uint32_t cap = _txCapacity();
+    uint32_t used = _txUsed(head, _txTailCache);
+
+    // The tail only moves forward, so the cached copy never overstates the free space
+    if (cap - used < dataSize)
+    {
+        _txTailCache = streamLoadAcquire(_txTail);
+        used = _txUsed(head, _txTailCache);
+    }
+    return (used >= cap) ? 0 : (cap - used);
 }
 
-uint32_t Stream::txContiguousSize() const
+uint32_t Stream::_rxRingFree(uint32_t dataSize)
 {
-    if (_txType != BUFFER_RING) return availableTx();
-    if (!_txBuffer || _txBufferSize < 2) return 0;
+    const uint32_t head = _rxHead;
+    const uint32_t cap = _rxCapacity();
+    uint32_t used = _rxUsed(head, _rxTailCache);
 
-    uint32_t tail1, tail2, head;
-    do
+    if (cap - used < dataSize)
     {
-        tail1 = _txTail;
-        head  = _txHead;
-        tail2 = _txTail;
-    } while (tail1 != tail2);
-
-    uint32_t used = (head >= tail1) ? (head - tail1) : (_txBufferSize - (tail1 - head));
-    uint32_t toEnd = _txBufferSize - tail1;
-    return (used < toEnd) ? used : toEnd;
+        _rxTailCache = streamLoadAcquire(_rxTail);
+        used = _rxUsed(head, _rxTailCache);
+    }
+    return (used >= cap) ? 0 : (cap - used);
 }
 
-bool Stream::txPeekContiguous(const char*& ptr, uint32_t& len) const
+uint32_t Stream::_txRingAvailable(uint32_t dataSize)
 {
-    ptr = nullptr;
-    len = 0;
+    const uint32_t tail = _txTail;
+    uint32_t used = _txUsed(_txHeadCache, tail);
 
-    if (_txType != BUFFER_RING)
+    // The head only moves forward, so the cached copy never overstates the readable bytes
+    if (used < dataSize)
     {
-        if (!_txBuffer || _txBufferSize < 2) return false;
-        ptr = _txBuffer;
-        len = _txPosition;
-        return true;
+        _txHeadCache = streamLoadAcquire(_txHead);
+        used = _txUsed(_txHeadCache, tail);
     }
+    return used;
+}
 
-    if (!_txBuffer || _txBufferSize < 2) return false;
+uint32_t Stream::_rxRingAvailable(uint32_t dataSize)
+{
+    const uint32_t tail = _rxTail;
+    uint32_t used = _rxUsed(_rxHeadCache, tail);
+
+    if (used < dataSize)
+    {
+        _rxHeadCache = streamLoadAcquire(_rxHead);
+        used = _rxUsed(_rxHeadCache, tail);
+    }
+    return used;
+}
 
-    uint32_t tail1, tail2, head;
+void Stream::_bipSnapshot(const StreamIndex& head, const StreamIndex& tail, const StreamIndex& watermark,
+                          uint32_t& index1, uint32_t& len1, uint32_t& len2)
+{
+    // Reread the tail: the producer moves it to 0 when it restarts an empty buffer (see _bipReserve())
+    uint32_t tail1, tail2, head1;
     do
     {
-        tail1 = _txTail;
-        head  = _txHead;
-        tail2 = _txTail;
+        tail1 = streamLoadAcquire(tail);
+        head1 = streamLoadAcquire(head);
+        tail2 = streamLoadAcquire(tail);
     } while (tail1 != tail2);
 
-    uint32_t used = (head >= tail1) ? (head - tail1) : (_txBufferSize - (tail1 - head));
-    uint32_t toEnd = _txBufferSize - tail1;
+    len2 = 0;
+    if (head1 >= tail1)
+    {
+        index1 = tail1;
+        len1 = head1 - tail1;
+        return;
+    }
+
+    // Wrapped: data is [tail, watermark) followed by [0, head)
+    const uint32_t mark = streamLoadRelaxed(watermark);
+    if (tail1 >= mark)
+    {
+        index1 = 0;
+        len1 = head1;
+        return;
+    }
 
-    len = (used < toEnd) ? used : toEnd;
-    ptr = (len == 0) ? nullptr : &_txBuffer[tail1];
-    return true;
+    index1 = tail1;
+    len1 = mark - tail1;
+    len2 = head1;
 }
 
-uint32_t Stream::rxContiguousSize() const
+uint32_t Stream::_bipFree(uint32_t head, uint32_t tail, uint32_t bufferSize)
 {
-    if (_rxType != BUFFER_RING) return availableRx();
-    if (!_rxBuffer || _rxBufferSize < 2) return 0;
+    if (head == tail) return bufferSize;    // empty: the next reservation restarts at index 0
+    if (head < tail) return tail - head - 1;
 
-    uint32_t tail1, tail2, head;
-    do
+    const uint32_t atEnd = bufferSize - head;
+    const uint32_t atStart = (tail > 0) ? (tail - 1) : 0;
+    return (atEnd > atStart) ? atEnd : atStart;
+}
+
+bool Stream::_bipReserve(StreamIndex& head, StreamIndex& tail, StreamIndex& watermark, uint32_t bufferSize,
+                         uint32_t dataSize, uint32_t& start)
+{
+    const uint32_t head1 = streamLoadRelaxed(head);
+    const uint32_t tail1 = streamLoadAcquire(tail);
+
+    if (head1 == tail1)
     {
-        tail1 = _rxTail;
-        head  = _rxHead;
-        tail2 = _rxTail;
-    } while (tail1 != tail2);
+        // Empty: restart at index 0 so the whole buffer is contiguous. Every intermediate state
+        // reads as empty: [tail, watermark) is empty once head wraps, then tail follows.
+        if (head1 != 0)
+        {
+            streamStoreRelease(watermark, head1);
+            streamStoreRelease(head, 0);
+            streamStoreRelease(tail, 0);
+        }
+        if (dataSize > bufferSize) return false;
+        start = 0;
+        return true;
+    }
 
-    uint32_t used = (head >= tail1) ? (head - tail1) : (_rxBufferSize - (tail1 - head));
-    uint32_t toEnd = _rxBufferSize - tail1;
-    return (used < toEnd) ? used : toEnd;
+    if (head1 < tail1)
+    {
+        // Already wrapped: the gap up to tail must stay non-empty
+        if (tail1 - head1 <= dataSize) return false;
+        start = head1;
+        return true;
+    }
+
+    if (bufferSize - head1 >= dataSize)
+    {
+        start = head1;
+        return true;
+    }
+
+    // Wrap to the buffer start; the space [head, end) is skipped via the watermark
+    if (tail1 > dataSize)
+    {
+        start = 0;
+        return true;
+    }
+
+    return false;
 }
 
-uint32_t Stream::freeTx() const
+void Stream::_bipPublish(StreamIndex& head, StreamIndex& watermark, uint32_t start, uint32_t dataSize)
 {
-    if(!_txBuffer || _txBufferSize < 2) return 0;
-    uint32_t used = availableTx();
-    uint32_t cap = _txBufferSize - 1;
-    return (used >= cap) ? 0 : (cap - used);
+    const uint32_t head1 = streamLoadRelaxed(head);
+    if (start != head1) streamStoreRelease(watermark, head1);   // wrapped: mark the end of valid data
+    streamStoreRelease(head, start + dataSize);
 }
 
-uint32_t Stream::freeRx() const
+uint32_t Stream::_bipNextTail(uint32_t index1, uint32_t len1, uint32_t len2, uint32_t dataSize)
 {
-    if(!_rxBuffer || _rxBufferSize < 2) return 0;
-    uint32_t used = availableRx();
-    uint32_t cap = _rxBufferSize - 1;
-    return (used >= cap) ? 0 : (cap - used);
+    // Stay in the first segment, or continue from the buffer start once it is drained
+    return ((dataSize < len1) || (len2 == 0)) ? (index1 + dataSize) : (dataSize - len1);
 }
 
-bool Stream::writeTxBuffer(const char* data, uint32_t dataSize) 
+void Stream::_txLinearRemove(uint32_t dataSize)
 {
-    errorCode = STREAM_OK;
-
-    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
-    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
-    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
-
-    // capacity is (size - 1)
-    if (dataSize > (_txBufferSize - 1)) 
+    if (_txType == BUFFER_LINEAR_LAZY)
     {
-        errorCode = STREAM_ERR_PARAM;  // "Error Stream: Data size exceeds TX buffer size.";
-        return false;
+        // Only move the read offset; data is compacted when a write needs the space.
+        // Single writer: load and store, no read-modify-write on the atomic index.
+        const uint32_t tail = streamLoadRelaxed(_txTail) + dataSize;
+        if (tail == _txPosition)
+        {
+            streamStoreRelease(_txTail, 0);
+            _txPosition = 0;
+            _txBuffer[0] = '\0';
+        }
+        else streamStoreRelease(_txTail, tail);
+        return;
     }
 
-    clearTxBuffer();
-    return pushBackTxBuffer(data, dataSize);
+    std::memmove(_txBuffer, _txBuffer + dataSize, _txPosition - dataSize);
+    _txPosition -= dataSize;
+    _txBuffer[_txPosition] = '\0';
 }
 
-bool Stream::writeRxBuffer(const char* data, uint32_t dataSize) 
+void Stream::_txLinearMakeRoom(uint32_t dataSize)
 {
-    errorCode = STREAM_OK;
-
-    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
-    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
-    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
-
-    if (dataSize > (_rxBufferSize - 1)) 
+    if ((_txTail != 0) && ((_txCapacity() - _txPosition) < dataSize))
     {
-        errorCode = STREAM_ERR_PARAM;  // "Error Stream: Data size exceeds RX buffer size.";
-        return false;
+        const int8_t error = errorCode;     // keep the caller's error (e.g. short reservation)
+        compactTxBuffer();
+        errorCode = error;
     }
-    
-    clearRxBuffer();
-    return pushBackRxBuffer(data, dataSize);
 }
 
-bool Stream::pushBackTxBuffer(const char* data, uint32_t dataSize)
+void Stream::_rxLinearRemove(uint32_t dataSize)
 {
-    errorCode = STREAM_OK;
+    ++_rxReadEpoch;     // logical offsets shift (see findRxFrom())
 
-    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
-    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
-    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (_rxType == BUFFER_LINEAR_LAZY)
+    {
+        // Only move the read offset; data is compacted when a write needs the space.
+        // Single writer: load and store, no read-modify-write on the atomic index.
+        const uint32_t tail = streamLoadRelaxed(_rxTail) + dataSize;
+        if (tail == _rxPosition)
+        {
+            streamStoreRelease(_rxTail, 0);
+            _rxPosition = 0;
+            _rxBuffer[0] = '\0';
+        }
+        else streamStoreRelease(_rxTail, tail);
+        return;
+    }
+
+    std::memmove(_rxBuffer, _rxBuffer + dataSize, _rxPosition - dataSize);
+    _rxPosition -= dataSize;
+    _rxBuffer[_rxPosition] = '\0';
+}
 
-    // If message is larger than capacity, keep only the last part
-    if(dataSize > (_txBufferSize - 1))
+void Stream::_rxLinearMakeRoom(uint32_t dataSize)
+{
+    if ((_rxTail != 0) && ((_rxCapacity() - _rxPosition) < dataSize))
     {
-        data += (dataSize - (_txBufferSize - 1));
-        dataSize = (_txBufferSize - 1);
-        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; // indicate truncation
+        const int8_t error = errorCode;     // keep the caller's error (e.g. short reservation)
+        compactRxBuffer();
+        errorCode = error;
     }
+}
 
-    bool ret = (errorCode == STREAM_OK);
+#if STREAM_ENABLE_MPSC
+uint32_t Stream::_txMpscPush(const StreamConstSpan* spans, uint32_t count, uint32_t dataSize, bool allowPartial)
+{
+    const uint32_t cap = _txBufferSize;
+    const uint8_t slot = _txMpscEnter();
 
-    // TX producer-safe (main loop)
-    if (_txType == BUFFER_RING)
+    uint32_t claim = _atomicLoad(_txClaim);
+    uint32_t claimed = 0;
+    while (true)
     {
-        const uint32_t cap = _txBufferSize - 1;
+        // Announce where we claim from before claiming, so a publishing producer never passes our region.
+        _atomicStore(_txWriterStart[slot], claim);
 
-        if (dataSize > cap)
+        const uint32_t tail = _txTail;
+        const uint32_t free = cap - (claim - tail);
+        uint32_t n = dataSize;
+        if (n > free)
         {
-            data += (dataSize - cap);
-            dataSize = cap;
-            errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
-            ret = false;
+            if (!allowPartial || free == 0) break;
+            n = free;
         }
 
-        const uint32_t free = freeTx();
-        if (dataSize > free)
+        if (_atomicCas(_txClaim, claim, claim + n))
         {
-            errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
-            return false;
+            claimed = n;
+            break;
         }
-
-        const uint32_t head = _txHead;
-        const uint32_t toEnd = _txBufferSize - head;
-        const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
-
-        std::memcpy(&_txBuffer[head], data, first);
-        if (dataSize > first)
-            std::memcpy(&_txBuffer[0], data + first, dataSize - first);
-
-        STREAM_DMB();
-        _txHead = (head + dataSize) % _txBufferSize;
-        return ret;
     }
 
-    // LINEAR
-    uint32_t free = freeTx();
-    if(free < dataSize)
+    if (claimed != 0)
     {
-        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
-        ret = false;
-        uint32_t need = dataSize - free;
-        if(need > _txPosition) need = _txPosition;
-        removeFrontTxBuffer(need);
-    }
+        const uint32_t index = claim & _txMask;
+        const uint32_t toEnd = _txBufferSize - index;
+        const uint32_t first = (claimed < toEnd) ? claimed : toEnd;
 
-    // re-check space
-    free = freeTx();
-    if(free < dataSize) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+        _gatherCopy(&_txBuffer[index], first, &_txBuffer[0], claimed - first, spans, count);
+    }
 
-    // Copy the data into the buffer
-    std::memcpy(&_txBuffer[_txPosition], data, dataSize);
-    _txPosition += dataSize;    // Update the position
-    _txBuffer[_txPosition] = '\0';
-    return ret;
+    _txMpscLeave(slot);
+    return claimed;
 }
+#endif
 
-bool Stream::pushBackRxBuffer(const char* data, uint32_t dataSize)
+template <typename Span>
+bool Stream::_spansTotal(const Span* spans, uint32_t count, uint32_t& total)
 {
-    errorCode = STREAM_OK;
-
-    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
-    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
-    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }    
+    total = 0;
+    if (spans == nullptr) return (count == 0);
 
-    if(dataSize > (_rxBufferSize - 1))
+    for (uint32_t i = 0; i < count; ++i)
     {
-        data += (dataSize - (_rxBufferSize - 1));
-        dataSize = (_rxBufferSize - 1);
-        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; // indicate truncation
+        const uint32_t size = spans[i].size;
+        if (size == 0) continue;
+        if (spans[i].data == nullptr || (total + size) < total) return false;
+        total += size;
     }
+    return true;
+}
+
+void Stream::_gatherCopy(char* seg1, uint32_t len1, char* seg2, uint32_t len2, const StreamConstSpan* spans, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const char* src = spans[i].data;
+        uint32_t size = spans[i].size;
+
+        while (size != 0)
+        {
+            if (len1 == 0)
+            {
+                if (len2 == 0) return;
+                seg1 = seg2;        // continue in the second segment
+                len1 = len2;
+                len2 = 0;
+            }
 
-    bool ret = (errorCode == STREAM_OK);
+            const uint32_t n = (size < len1) ? size : len1;
+            std::memcpy(seg1, src, n);
+            seg1 += n;
+            len1 -= n;
+            src += n;
+            size -= n;
+        }
+    }
+}
 
-    // RX producer-safe (ISR)
-    if (_rxType == BUFFER_RING)
+void Stream::_scatterCopy(const char* seg1, uint32_t len1, const char* seg2, uint32_t len2, const StreamSpan* spans, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
     {
-        const uint32_t cap = _rxBufferSize - 1;
+        char* dst = spans[i].data;
+        uint32_t size = spans[i].size;
 
-        if (dataSize > cap)
+        while (size != 0)
         {
-            data += (dataSize - cap);
-            dataSize = cap;
-            errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
-            ret = false;
+            if (len1 == 0)
+            {
+                if (len2 == 0) return;
+                seg1 = seg2;        // continue in the second segment
+                len1 = len2;
+                len2 = 0;
+            }
+
+            const uint32_t n = (size < len1) ? size : len1;
+            std::memcpy(dst, seg1, n);
+            seg1 += n;
+            len1 -= n;
+            dst += n;
+            size -= n;
         }
+    }
+}
 
-        const uint32_t free = freeRx();
-        if (dataSize > free)
+#if STREAM_ENABLE_MPSC
+uint8_t Stream::_txMpscEnter()
+{
+    while (true)
+    {
+        for (uint8_t slot = 0; slot < STREAM_MPSC_MAX_WRITERS; ++slot)
         {
-            errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
-            return false;
+            uint32_t idle = 0;
+            if (_atomicCas(_txWriterActive[slot], idle, 1)) return slot;
         }
 
-        const uint32_t head = _rxHead;
-        const uint32_t toEnd = _rxBufferSize - head;
-        const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
+        #if defined(_PLATFORM_PC_)
+            std::this_thread::yield();
+        #endif
+    }
+}
 
-        std::memcpy(&_rxBuffer[head], data, first);
-        if (dataSize > first)
-            std::memcpy(&_rxBuffer[0], data + first, dataSize - first);
+void Stream::_txMpscLeave(uint8_t slot)
+{
+    // Our bytes are written. Publish up to the oldest region another writer is still copying:
+    // the consumer only ever sees fully written bytes, in claim order, and a stalled writer
+    // holds back only the bytes claimed after its own. The last writer out publishes the rest.
+    _atomicStore(_txWriterActive[slot], 0);
 
-        STREAM_DMB();
-        _rxHead = (head + dataSize) % _rxBufferSize;
-        return ret;
+    const uint32_t claim = _atomicLoad(_txClaim);
+    uint32_t ready = claim;
+    for (uint8_t other = 0; other < STREAM_MPSC_MAX_WRITERS; ++other)
+    {
+        if (_atomicLoad(_txWriterActive[other]) == 0) continue;
+        const uint32_t start = _atomicLoad(_txWriterStart[other]);
+        if (static_cast<int32_t>(start - ready) < 0) ready = start;
     }
 
-    // LINEAR
-    uint32_t free = freeRx();
-    if(free < dataSize)
+    uint32_t head = _atomicLoad(_txHead);
+    while (static_cast<int32_t>(ready - head) > 0)
     {
+        if (_atomicCas(_txHead, head, ready)) break;
+    }
+}
+#endif
+
+StreamOverflowPolicy Stream::_txOverflowMode() const
+{
+    const bool linear = (_txType == BUFFER_LINEAR) || (_txType == BUFFER_LINEAR_LAZY);
+    if (_txOverflowPolicy == STREAM_OVERFLOW_AUTO)
+        return linear ? STREAM_OVERFLOW_DROP_OLDEST : STREAM_OVERFLOW_REJECT;
+
+    // The producer can not move the tail of a bip buffer or of a multi-producer ring
+    if (_txOverflowPolicy == STREAM_OVERFLOW_DROP_OLDEST && (_txType == BUFFER_BIP || _txType == BUFFER_RING_MPSC))
+        return STREAM_OVERFLOW_REJECT;
+
+    return _txOverflowPolicy;
+}
+
+StreamOverflowPolicy Stream::_rxOverflowMode() const
+{
+    const bool linear = (_rxType == BUFFER_LINEAR) || (_rxType == BUFFER_LINEAR_LAZY);
+    if (_rxOverflowPolicy == STREAM_OVERFLOW_AUTO)
+        return linear ? STREAM_OVERFLOW_DROP_OLDEST : STREAM_OVERFLOW_REJECT;
+
+    if (_rxOverflowPolicy == STREAM_OVERFLOW_DROP_OLDEST && _rxType == BUFFER_BIP)
+        return STREAM_OVERFLOW_REJECT;
+
+    return _rxOverflowPolicy;
+}
+
+void Stream::_txCountDrop(uint32_t droppedBytes)
+{
+#if STREAM_ENABLE_MPSC
+    if (_txType == BUFFER_RING_MPSC)
+    {
+        // Several producers may overflow at the same time
+        _atomicAddFetch(_txDropEvents, 1);
+        if (droppedBytes != 0) _atomicAddFetch(_txDroppedBytes, droppedBytes);
+        return;
+    }
+#endif
+
+    // Single producer: the counters have one writer, no read-modify-write needed
+    streamStoreRelease(_txDropEvents, _txDropEvents + 1);
+    if (droppedBytes != 0) streamStoreRelease(_txDroppedBytes, _txDroppedBytes + droppedBytes);
+}
+
+void Stream::_rxCountDrop(uint32_t droppedBytes)
+{
+    // RX has one producer: the counters have one writer
+    streamStoreRelease(_rxDropEvents, _rxDropEvents + 1);
+    if (droppedBytes != 0) streamStoreRelease(_rxDroppedBytes, _rxDroppedBytes + droppedBytes);
+}
+
+void Stream::_notifyWaiters()
+{
+    #if defined(_PLATFORM_PC_)
+        // Hot path: no fence. A waiter registering at this very moment may be missed; it
+        // rechecks on its own after STREAM_WAIT_RECHECK_MS (see _waitUntil()).
+        if (_waiters.load(std::memory_order_relaxed) == 0) return;
+
+        // Taking the lock orders the notify after a waiter that is between its check and its sleep.
+        { std::lock_guard<std::mutex> lock(_waitMutex); }
+        _waitCond.notify_all();
+    #endif
+}
+
+#if defined(_PLATFORM_PC_)
+    template <typename Ready>
+    bool Stream::_waitUntil(Ready ready, uint32_t timeoutMs)
+    {
+        if (ready()) return true;
+        if (timeoutMs == 0) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        _waiters.fetch_add(1);
+
+        bool ok;
+        {
+            // The first sleep is short: a producer that published while this thread registered
+            // may have missed the registration and not notified (see _notifyWaiters()).
+            std::unique_lock<std::mutex> lock(_waitMutex);
+            const uint32_t recheckMs = (timeoutMs < STREAM_WAIT_RECHECK_MS) ? timeoutMs : STREAM_WAIT_RECHECK_MS;
+            ok = _waitCond.wait_for(lock, std::chrono::milliseconds(recheckMs), ready);
+            if (!ok)
+            {
+                if (timeoutMs == STREAM_WAIT_FOREVER)
+                {
+                    _waitCond.wait(lock, ready);
+                    ok = true;
+                }
+                else
+                {
+                    ok = _waitCond.wait_until(lock, deadline, ready);
+                }
+            }
+        }
+
+        _waiters.fetch_sub(1);
+        if (!ok) errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;    // timeout
+        return ok;
+    }
+
+    bool Stream::waitRxAvailable(uint32_t dataSize, uint32_t timeoutMs)
+    {
+        errorCode = STREAM_OK;
+        if (!_rxBuffer || _rxBufferSize < 2 || dataSize > _rxCapacity()) { errorCode = STREAM_ERR_PARAM; return false; }
+
+        return _waitUntil([this, dataSize]() { return availableRx() >= dataSize; }, timeoutMs);
+    }
+
+    bool Stream::waitRxDelimiter(char delimiter, uint32_t timeoutMs)
+    {
+        errorCode = STREAM_OK;
+        if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+        return _waitUntil([this, delimiter]() { return findRx(delimiter) != SIZE_MAX; }, timeoutMs);
+    }
+
+    bool Stream::waitTxFree(uint32_t dataSize, uint32_t timeoutMs)
+    {
+        errorCode = STREAM_OK;
+        if (!_txBuffer || _txBufferSize < 2 || dataSize > _txCapacity()) { errorCode = STREAM_ERR_PARAM; return false; }
+
+        return _waitUntil([this, dataSize]() { return freeTx() >= dataSize; }, timeoutMs);
+    }
+#endif
+
+#if STREAM_ATOMIC_IRQ_LOCK
+    #if defined(__CC_ARM)
+        uint32_t Stream::_irqLock()
+        {
+            register uint32_t primask __asm("primask");
+            const uint32_t saved = primask;
+            __disable_irq();
+            return saved;
+        }
+
+        void Stream::_irqUnlock(uint32_t saved)
+        {
+            register uint32_t primask __asm("primask");
+            primask = saved;
+        }
+    #else
+        uint32_t Stream::_irqLock()
+        {
+            uint32_t saved;
+            __asm volatile("mrs %0, primask\n cpsid i" : "=r"(saved) :: "memory");
+            return saved;
+        }
+
+        void Stream::_irqUnlock(uint32_t saved)
+        {
+            __asm volatile("msr primask, %0" :: "r"(saved) : "memory");
+        }
+    #endif
+#endif
+
+#if STREAM_ATOMIC_RMW
+uint32_t Stream::_atomicLoad(const StreamIndex& value)
+{
+#if STREAM_USE_STD_ATOMIC
+    return value.load();
+#elif (defined(__GNUC__) || defined(__clang__)) && !defined(__CC_ARM)
+    return __atomic_load_n(&value, __ATOMIC_SEQ_CST);
+#else
+    STREAM_DMB();
+    const uint32_t result = value;
+    STREAM_DMB();
+    return result;
+#endif
+}
+
+void Stream::_atomicStore(StreamIndex& value, uint32_t desired)
+{
+#if STREAM_USE_STD_ATOMIC
+    value.store(desired);
+#elif (defined(__GNUC__) || defined(__clang__)) && !defined(__CC_ARM)
+    __atomic_store_n(&value, desired, __ATOMIC_SEQ_CST);
+#else
+    STREAM_DMB();
+    value = desired;
+    STREAM_DMB();
+#endif
+}
+
+uint32_t Stream::_atomicAddFetch(StreamIndex& value, uint32_t delta)
+{
+#if STREAM_USE_STD_ATOMIC
+    return value.fetch_add(delta) + delta;
+#elif STREAM_ATOMIC_IRQ_LOCK
+    const uint32_t primask = _irqLock();
+    const uint32_t result = value + delta;
+    value = result;
+    _irqUnlock(primask);
+    return result;
+#elif defined(__GNUC__) || defined(__clang__)
+    return __atomic_add_fetch(&value, delta, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+    return static_cast<uint32_t>(_InterlockedExchangeAdd(reinterpret_cast<volatile long*>(&value), static_cast<long>(delta))) + delta;
+#else
+    #error "Stream: no atomic read-modify-write for this compiler; set STREAM_ENABLE_MPSC 0 and STREAM_MAX_RX_READERS 0, or STREAM_ATOMIC_IRQ_LOCK 1 on a single-core Cortex-M"
+#endif
+}
+
+bool Stream::_atomicCas(StreamIndex& value, uint32_t& expected, uint32_t desired)
+{
+#if STREAM_USE_STD_ATOMIC
+    return value.compare_exchange_strong(expected, desired);
+#elif STREAM_ATOMIC_IRQ_LOCK
+    const uint32_t primask = _irqLock();
+    const uint32_t current = value;
+    if (current == expected) value = desired;
+    _irqUnlock(primask);
+    if (current == expected) return true;
+    expected = current;
+    return false;
+#elif defined(__GNUC__) || defined(__clang__)
+    return __atomic_compare_exchange_n(&value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+    const uint32_t previous = static_cast<uint32_t>(_InterlockedCompareExchange(reinterpret_cast<volatile long*>(&value), static_cast<long>(desired), static_cast<long>(expected)));
+    if (previous == expected) return true;
+    expected = previous;
+    return false;
+#else
+    #error "Stream: no atomic compare-and-swap for this compiler; set STREAM_ENABLE_MPSC 0 and STREAM_MAX_RX_READERS 0, or STREAM_ATOMIC_IRQ_LOCK 1 on a single-core Cortex-M"
+#endif
+}
+#endif
+
+const char* Stream::getTxBuffer() const
+{
+    return _txBuffer;       // always base pointer
+}
+
+uint32_t Stream::getTxBufferSize() const
+{
+    return _txBufferSize;
+}
+
+const char* Stream::getRxBuffer() const
+{
+    return _rxBuffer;       // always base pointer
+}
+
+const char* Stream::txReadPtr() const
+{
+    if (_txType == BUFFER_BIP)
+    {
+        if (!_txBuffer || _txBufferSize < 2) return nullptr;
+        uint32_t index1, len1, len2;
+        _txBipSnapshot(index1, len1, len2);
+        return &_txBuffer[index1];
+    }
+
+    if (_isTxRing())
+    {
+        if (!_txBuffer || _txBufferSize < 2) return nullptr;
+        return &_txBuffer[_txIndex(_txTail)];
+    }
+    if (_txType == BUFFER_LINEAR_LAZY && _txBuffer) return &_txBuffer[_txTail];
+    return _txBuffer;
+}
+
+const char* Stream::rxReadPtr() const
+{
+    if (_rxType == BUFFER_BIP)
+    {
+        if (!_rxBuffer || _rxBufferSize < 2) return nullptr;
+        uint32_t index1, len1, len2;
+        _rxBipSnapshot(index1, len1, len2);
+        return &_rxBuffer[index1];
+    }
+
+    if (_isRxRing())
+    {
+        if (!_rxBuffer || _rxBufferSize < 2) return nullptr;
+        return &_rxBuffer[_rxIndex(_rxTail)];
+    }
+    if (_rxType == BUFFER_LINEAR_LAZY && _rxBuffer) return &_rxBuffer[_rxTail];
+    return _rxBuffer;
+}
+
+const char* Stream::compactTxBuffer()
+{
+    errorCode = STREAM_OK;
+
+    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return nullptr; }
+    if (_txType != BUFFER_LINEAR && _txType != BUFFER_LINEAR_LAZY) { errorCode = STREAM_ERR_PARAM; return nullptr; }
+
+    if (_txTail != 0)
+    {
+        const uint32_t used = _txPosition - _txTail;
+        std::memmove(_txBuffer, _txBuffer + _txTail, used);
+        _txPosition = used;
+        _txTail = 0;
+        _txBuffer[_txPosition] = '\0';
+    }
+
+    return _txBuffer;
+}
+
+const char* Stream::compactRxBuffer()
+{
+    errorCode = STREAM_OK;
+
+    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return nullptr; }
+    if (_rxType != BUFFER_LINEAR && _rxType != BUFFER_LINEAR_LAZY) { errorCode = STREAM_ERR_PARAM; return nullptr; }
+
+    if (_rxTail != 0)
+    {
+        const uint32_t used = _rxPosition - _rxTail;
+        std::memmove(_rxBuffer, _rxBuffer + _rxTail, used);
+        _rxPosition = used;
+        _rxTail = 0;
+        _rxBuffer[_rxPosition] = '\0';
+    }
+
+    return _rxBuffer;
+}
+
+uint32_t Stream::getRxBufferSize() const
+{
+    return _rxBufferSize;
+}
+
+void Stream::resetTxDropStats()
+{
+    _txDroppedBytes = 0;
+    _txDropEvents = 0;
+}
+
+void Stream::resetRxDropStats()
+{
+    _rxDroppedBytes = 0;
+    _rxDropEvents = 0;
+}
+
+void Stream::clearTxBuffer() 
+{
+    errorCode = STREAM_OK;
+    if (_txBuffer && _txBufferSize) memset(_txBuffer, 0, _txBufferSize);    // Zero out TX buffers
+    
+    _txPosition = 0;
+    _txHead = _txTail = 0;
+    _txTailCache = _txHeadCache = 0;
+    _txWatermark = 0;
+    _txBipStart = 0;
+    _txBipReserved = 0;
+#if STREAM_ENABLE_MPSC
+    _txClaim = 0;
+    for (uint8_t i = 0; i < STREAM_MPSC_MAX_WRITERS; ++i) _txWriterActive[i] = 0;
+#endif
+    _notifyWaiters();
+}
+
+void Stream::clearRxBuffer() 
+{
+    errorCode = STREAM_OK;
+    if (_rxBuffer && _rxBufferSize) memset(_rxBuffer, 0, _rxBufferSize);    // Zero out RX buffer
+    
+    _rxPosition = 0;
+    _rxHead = _rxTail = 0;
+    _rxTailCache = _rxHeadCache = 0;
+    ++_rxReadEpoch;
+    _rxWatermark = 0;
+    _rxBipStart = 0;
+    _rxBipReserved = 0;
+#if STREAM_MAX_RX_READERS > 0
+    for (uint8_t i = 0; i < STREAM_MAX_RX_READERS; ++i) _rxReaderTail[i] = 0;
+#endif
+}
+
+uint32_t Stream::txContiguousSize() const
+{
+    if (!_txBuffer || _txBufferSize < 2) return 0;
+
+    if (_txType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _txBipSnapshot(index1, len1, len2);
+        return len1;
+    }
+
+    if (!_isTxRing()) return availableTx();
+
+    uint32_t tail1, head;
+    _txSnapshot(head, tail1);
+
+    uint32_t used = _txUsed(head, tail1);
+    uint32_t toEnd = _txBufferSize - _txIndex(tail1);
+    return (used < toEnd) ? used : toEnd;
+}
+
+bool Stream::txPeekContiguous(const char*& ptr, uint32_t& len) const
+{
+    ptr = nullptr;
+    len = 0;
+
+    if (!_txBuffer || _txBufferSize < 2) return false;
+
+    if (_txType == BUFFER_BIP)
+    {
+        uint32_t index1, len2;
+        _txBipSnapshot(index1, len, len2);
+        ptr = (len == 0) ? nullptr : &_txBuffer[index1];
+        return true;
+    }
+
+    if (!_isTxRing())
+    {
+        len = _txPosition - _txTail;
+        ptr = &_txBuffer[_txTail];
+        return true;
+    }
+
+    uint32_t tail1, head;
+    _txSnapshot(head, tail1);
+
+    uint32_t used = _txUsed(head, tail1);
+    uint32_t toEnd = _txBufferSize - _txIndex(tail1);
+
+    len = (used < toEnd) ? used : toEnd;
+    ptr = (len == 0) ? nullptr : &_txBuffer[_txIndex(tail1)];
+    return true;
+}
+
+bool Stream::rxPeek(const char*& seg1, uint32_t& len1, const char*& seg2, uint32_t& len2) const
+{
+    seg1 = seg2 = nullptr;
+    len1 = len2 = 0;
+
+    if (!_rxBuffer || _rxBufferSize < 2) return false;
+
+    if (_rxType == BUFFER_BIP)
+    {
+        uint32_t index1;
+        _rxBipSnapshot(index1, len1, len2);
+        if (len1) seg1 = &_rxBuffer[index1];
+        if (len2) seg2 = &_rxBuffer[0];
+        return true;
+    }
+
+    if (!_isRxRing())
+    {
+        len1 = _rxPosition - _rxTail;
+        seg1 = (len1 == 0) ? nullptr : &_rxBuffer[_rxTail];
+        return true;
+    }
+
+    uint32_t tail1, head;
+    _rxSnapshot(head, tail1);
+
+    const uint32_t used = _rxUsed(head, tail1);
+    if (used == 0) return true;
+
+    const uint32_t index = _rxIndex(tail1);
+    const uint32_t toEnd = _rxBufferSize - index;
+
+    seg1 = &_rxBuffer[index];
+    len1 = (used < toEnd) ? used : toEnd;
+    if (used > len1)
+    {
+        seg2 = &_rxBuffer[0];
+        len2 = used - len1;
+    }
+    return true;
+}
+
+bool Stream::_txPeek(const char*& seg1, uint32_t& len1, const char*& seg2, uint32_t& len2) const
+{
+    seg1 = seg2 = nullptr;
+    len1 = len2 = 0;
+
+    if (!_txBuffer || _txBufferSize < 2) return false;
+
+    if (_txType == BUFFER_BIP)
+    {
+        uint32_t index1;
+        _txBipSnapshot(index1, len1, len2);
+        if (len1) seg1 = &_txBuffer[index1];
+        if (len2) seg2 = &_txBuffer[0];
+        return true;
+    }
+
+    if (!_isTxRing())
+    {
+        len1 = _txPosition - _txTail;
+        seg1 = (len1 == 0) ? nullptr : &_txBuffer[_txTail];
+        return true;
+    }
+
+    uint32_t tail1, head;
+    _txSnapshot(head, tail1);
+
+    const uint32_t used = _txUsed(head, tail1);
+    if (used == 0) return true;
+
+    const uint32_t index = _txIndex(tail1);
+    const uint32_t toEnd = _txBufferSize - index;
+
+    seg1 = &_txBuffer[index];
+    len1 = (used < toEnd) ? used : toEnd;
+    if (used > len1)
+    {
+        seg2 = &_txBuffer[0];
+        len2 = used - len1;
+    }
+    return true;
+}
+
+bool Stream::rxConsume(uint32_t dataSize)
+{
+    if (!_isRxRing()) return removeFrontRxBuffer(dataSize);    // linear and bip
+
+    errorCode = STREAM_OK;
+    if (dataSize == 0) return true;
+
+    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (dataSize > _rxRingAvailable(dataSize)) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    const uint32_t tail = _rxTail;
+    // Release: finish in-place reads before the space goes back to the producer
+    _rxSetTail(_rxAdvance(tail, dataSize));
+    return true;
+}
+
+uint32_t Stream::rxContiguousSize() const
+{
+    if (!_rxBuffer || _rxBufferSize < 2) return 0;
+
+    if (_rxType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _rxBipSnapshot(index1, len1, len2);
+        return len1;
+    }
+
+    if (!_isRxRing()) return availableRx();
+
+    uint32_t tail1, head;
+    _rxSnapshot(head, tail1);
+
+    uint32_t used = _rxUsed(head, tail1);
+    uint32_t toEnd = _rxBufferSize - _rxIndex(tail1);
+    return (used < toEnd) ? used : toEnd;
+}
+
+uint32_t Stream::freeTx() const
+{
+    if(!_txBuffer || _txBufferSize < 2) return 0;
+    if (_txType == BUFFER_BIP) return _bipFree(_txHead, _txTail, _txBufferSize);
+    uint32_t used = availableTx();
+    uint32_t cap = _txCapacity();
+    return (used >= cap) ? 0 : (cap - used);
+}
+
+uint32_t Stream::freeRx() const
+{
+    if(!_rxBuffer || _rxBufferSize < 2) return 0;
+    if (_rxType == BUFFER_BIP) return _bipFree(_rxHead, _rxTail, _rxBufferSize);
+    uint32_t used = availableRx();
+    if (_rxReaderCount != 0)
+    {
+        // Free space is limited by the slowest attached reader
+        const uint32_t readersUsed = _rxReadersMaxUsed(_rxHead);
+        if (readersUsed > used) used = readersUsed;
+    }
+    uint32_t cap = _rxCapacity();
+    return (used >= cap) ? 0 : (cap - used);
+}
+
+bool Stream::writeTxBuffer(const char* data, uint32_t dataSize) 
+{
+    errorCode = STREAM_OK;
+
+    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    // capacity is (size - 1)
+    if (dataSize > _txCapacity()) 
+    {
+        errorCode = STREAM_ERR_PARAM;  // "Error Stream: Data size exceeds TX buffer size.";
+        return false;
+    }
+
+    clearTxBuffer();
+    return pushBackTxBuffer(data, dataSize);
+}
+
+bool Stream::writeRxBuffer(const char* data, uint32_t dataSize) 
+{
+    errorCode = STREAM_OK;
+
+    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    if (dataSize > _rxCapacity()) 
+    {
+        errorCode = STREAM_ERR_PARAM;  // "Error Stream: Data size exceeds RX buffer size.";
+        return false;
+    }
+    
+    clearRxBuffer();
+    return pushBackRxBuffer(data, dataSize);
+}
+
+bool Stream::pushBackTxBuffer(const char* data, uint32_t dataSize)
+{
+    errorCode = STREAM_OK;
+    _txLastPushSize = 0;
+
+    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    const StreamOverflowPolicy policy = _txOverflowMode();
+
+#if STREAM_ENABLE_MPSC
+    if (_txType == BUFFER_RING_MPSC)
+    {
+        const bool partial = (policy == STREAM_OVERFLOW_DROP_NEWEST) || (policy == STREAM_OVERFLOW_PARTIAL);
+        const StreamConstSpan span = { data, dataSize };
+        const uint32_t written = _txMpscPush(&span, 1, dataSize, partial);
+        _txLastPushSize = written;
+        if (written == dataSize) return true;
+
+        _txCountDrop((policy == STREAM_OVERFLOW_PARTIAL) ? 0 : (dataSize - written));
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        return false;
+    }
+#endif
+
+    // Legacy ring behaviour (STREAM_OVERFLOW_AUTO): keep only the last part of a message larger
+    // than the capacity, then write it if it fits (the call still returns false)
+    uint32_t truncated = 0;
+    if (_txOverflowPolicy == STREAM_OVERFLOW_AUTO && _isTxRing() && dataSize > _txCapacity())
+    {
+        truncated = dataSize - _txCapacity();
+        data += truncated;
+        dataSize -= truncated;
+    }
+
+    uint32_t free = _isTxRing() ? _txRingFree(dataSize) : freeTx();
+    const bool overflow = (dataSize > free);
+    if (overflow)
+    {
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        uint32_t dropped = truncated;
+
+        if (policy == STREAM_OVERFLOW_DROP_OLDEST)
+        {
+            // If message is larger than capacity, keep only the last part
+            const uint32_t cap = _txCapacity();
+            if (dataSize > cap)
+            {
+                dropped += dataSize - cap;
+                data += (dataSize - cap);
+                dataSize = cap;
+            }
+
+            if (dataSize > free)
+            {
+                // Writes consumer state: only valid with a quiescent consumer (see StreamOverflowPolicy)
+                const uint32_t evict = dataSize - free;
+                if (_isTxRing())
+                {
+                    _txTail = _txAdvance(_txTail, evict);
+                    _txTailCache = _txTail;
+                    _txHeadCache = _txHead;     // the consumer copy must not lag behind the moved tail
+                }
+                else _txLinearRemove(evict);
+                dropped += evict;
+            }
+
+            free = freeTx();
+            if (dataSize > free)
+            {
+                dropped += dataSize;
+                dataSize = 0;
+            }
+        }
+        else
+        {
+            const uint32_t fit = (policy == STREAM_OVERFLOW_REJECT) ? 0 : free;
+            if (policy != STREAM_OVERFLOW_PARTIAL) dropped += dataSize - fit;
+            dataSize = fit;
+        }
+
+        _txCountDrop(dropped);
+        if (dataSize == 0) return false;
+    }
+    else if (truncated != 0)
+    {
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        _txCountDrop(truncated);
+    }
+
+    if (_txType == BUFFER_BIP)
+    {
+        // Contiguous write (a frame never straddles the buffer end); dataSize <= freeTx() always fits
+        uint32_t start = 0;
+        _txBipReserve(dataSize, start);
+        std::memcpy(&_txBuffer[start], data, dataSize);
+        _txBipPublish(start, dataSize);
+    }
+    else if (_isTxRing())
+    {
+        // TX producer-safe (main loop)
+        const uint32_t head = _txHead;
+        const uint32_t index = _txIndex(head);
+        const uint32_t toEnd = _txBufferSize - index;
+        const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
+
+        std::memcpy(&_txBuffer[index], data, first);
+        if (dataSize > first)
+            std::memcpy(&_txBuffer[0], data + first, dataSize - first);
+
+        streamStoreRelease(_txHead, _txAdvance(head, dataSize));
+    }
+    else
+    {
+        // LINEAR: copy the data into the buffer
+        _txLinearMakeRoom(dataSize);
+        std::memcpy(&_txBuffer[_txPosition], data, dataSize);
+        _txPosition += dataSize;    // Update the position
+        _txBuffer[_txPosition] = '\0';
+    }
+
+    _txLastPushSize = dataSize;
+    if (overflow || truncated != 0)
+    {
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        return false;
+    }
+    return true;
+}
+
+bool Stream::pushBackRxBuffer(const char* data, uint32_t dataSize)
+{
+    errorCode = STREAM_OK;
+    _rxLastPushSize = 0;
+
+    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    const StreamOverflowPolicy policy = _rxOverflowMode();
+
+    // Lagging attached readers: apply the reader policy before computing free space
+    if (_rxReaderCount != 0 && _isRxRing())
+        _rxReadersMakeRoom((dataSize < _rxCapacity()) ? dataSize : _rxCapacity());
+
+    // Legacy ring behaviour (STREAM_OVERFLOW_AUTO): keep only the last part of a message larger
+    // than the capacity, then write it if it fits (the call still returns false)
+    uint32_t truncated = 0;
+    if (_rxOverflowPolicy == STREAM_OVERFLOW_AUTO && _isRxRing() && dataSize > _rxCapacity())
+    {
+        truncated = dataSize - _rxCapacity();
+        data += truncated;
+        dataSize -= truncated;
+    }
+
+    uint32_t free = (_isRxRing() && _rxReaderCount == 0) ? _rxRingFree(dataSize) : freeRx();
+    const bool overflow = (dataSize > free);
+    if (overflow)
+    {
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        uint32_t dropped = truncated;
+
+        if (policy == STREAM_OVERFLOW_DROP_OLDEST)
+        {
+            // If message is larger than capacity, keep only the last part
+            const uint32_t cap = _rxCapacity();
+            if (dataSize > cap)
+            {
+                dropped += dataSize - cap;
+                data += (dataSize - cap);
+                dataSize = cap;
+            }
+
+            // Blocking readers keep their bytes: evicting the main reader only helps if they leave room
+            uint32_t reclaimable = cap;
+            if (_rxReaderCount != 0 && _isRxRing())
+            {
+                const uint32_t readersUsed = _rxReadersMaxUsed(_rxHead);
+                reclaimable = (readersUsed >= cap) ? 0 : (cap - readersUsed);
+            }
+
+            if (dataSize > reclaimable)
+            {
+                dropped += dataSize;
+                dataSize = 0;
+            }
+            else if (dataSize > free)
+            {
+                // Writes consumer state: only valid with a quiescent consumer (see StreamOverflowPolicy)
+                const uint32_t evict = dataSize - free;
+                if (_isRxRing())
+                {
+                    _rxSetTail(_rxAdvance(_rxTail, evict));
+                    _rxTailCache = _rxTail;
+                    _rxHeadCache = _rxHead;     // the consumer copy must not lag behind the moved tail
+                }
+                else _rxLinearRemove(evict);
+                dropped += evict;
+            }
+
+            free = freeRx();
+            if (dataSize > free)
+            {
+                dropped += dataSize;
+                dataSize = 0;
+            }
+        }
+        else
+        {
+            const uint32_t fit = (policy == STREAM_OVERFLOW_REJECT) ? 0 : free;
+            if (policy != STREAM_OVERFLOW_PARTIAL) dropped += dataSize - fit;
+            dataSize = fit;
+        }
+
+        _rxCountDrop(dropped);
+        if (dataSize == 0) return false;
+    }
+    else if (truncated != 0)
+    {
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        _rxCountDrop(truncated);
+    }
+
+    if (_rxType == BUFFER_BIP)
+    {
+        // Contiguous write (a frame never straddles the buffer end); dataSize <= freeRx() always fits
+        uint32_t start = 0;
+        _rxBipReserve(dataSize, start);
+        std::memcpy(&_rxBuffer[start], data, dataSize);
+        _rxBipPublish(start, dataSize);
+    }
+    else if (_isRxRing())
+    {
+        // RX producer-safe (ISR)
+        const uint32_t head = _rxHead;
+        const uint32_t index = _rxIndex(head);
+        const uint32_t toEnd = _rxBufferSize - index;
+        const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
+
+        std::memcpy(&_rxBuffer[index], data, first);
+        if (dataSize > first)
+            std::memcpy(&_rxBuffer[0], data + first, dataSize - first);
+
+        streamStoreRelease(_rxHead, _rxAdvance(head, dataSize));
+    }
+    else
+    {
+        // LINEAR: copy the data into the buffer
+        _rxLinearMakeRoom(dataSize);
+        std::memcpy(&_rxBuffer[_rxPosition], data, dataSize);
+        _rxPosition += dataSize;    // Update the position
+        _rxBuffer[_rxPosition] = '\0';
+    }
+
+    _notifyWaiters();
+    _rxLastPushSize = dataSize;
+    if (overflow || truncated != 0)
+    {
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        return false;
+    }
+    return true;
+}
+
+bool Stream::pushBackTxBufferV(const StreamConstSpan* spans, uint32_t count)
+{
+    errorCode = STREAM_OK;
+    _txLastPushSize = 0;
+
+    uint32_t total;
+    if (!_spansTotal(spans, count, total)) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (total == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    bool ok;
+#if STREAM_ENABLE_MPSC
+    if (_txType == BUFFER_RING_MPSC)
+    {
+        ok = (_txMpscPush(spans, count, total, false) == total);
+    }
+    else
+#endif
+    {
+        // One space check (reserve), one copy pass, one publication (commit)
+        char* seg1;
+        char* seg2;
+        uint32_t len1, len2;
+        ok = (reserveTx(total, seg1, len1, seg2, len2) == total);
+        if (ok)
+        {
+            _gatherCopy(seg1, len1, seg2, len2, spans, count);
+            commitTx(total);
+        }
+    }
+
+    if (!ok)
+    {
+        _txCountDrop(total);
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        return false;
+    }
+
+    _txLastPushSize = total;
+    return true;
+}
+
+bool Stream::pushBackRxBufferV(const StreamConstSpan* spans, uint32_t count)
+{
+    errorCode = STREAM_OK;
+    _rxLastPushSize = 0;
+
+    uint32_t total;
+    if (!_spansTotal(spans, count, total)) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (total == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    char* seg1;
+    char* seg2;
+    uint32_t len1, len2;
+    if (reserveRx(total, seg1, len1, seg2, len2) != total)
+    {
+        _rxCountDrop(total);
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        return false;
+    }
+
+    _gatherCopy(seg1, len1, seg2, len2, spans, count);
+    commitRx(total);    // also wakes blocked readers
+    _rxLastPushSize = total;
+    return true;
+}
+
+#if defined(_PLATFORM_PC_)
+    bool Stream::pushBackTxBuffer(const std::string& data)
+    {
+        return pushBackTxBuffer(data.c_str(), data.size());
+    }
+
+    bool Stream::pushBackRxBuffer(const std::string& data)
+    {
+        return pushBackRxBuffer(data.c_str(), data.size());
+    }
+#endif
+
+bool Stream::popFrontTxBuffer(char* data, uint32_t dataSize)
+{
+    errorCode = STREAM_OK;
+
+    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    bool ret = true;
+
+    uint32_t avail = _isTxRing() ? _txRingAvailable(dataSize) : availableTx();
+    if (dataSize > avail) 
+    {
+        dataSize = avail;
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; // Not enough data in the buffer to pop
+        ret = false;
+    }
+
+    if (_txType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _txBipSnapshot(index1, len1, len2);
+        const uint32_t first = (dataSize < len1) ? dataSize : len1;
+
+        std::memcpy(data, &_txBuffer[index1], first);
+        if (dataSize > first)
+            std::memcpy(data + first, &_txBuffer[0], dataSize - first);
+
+        streamStoreRelease(_txTail, _bipNextTail(index1, len1, len2, dataSize));
+        _notifyWaiters();
+        return ret;
+    }
+
+    if (_isTxRing())
+    {
+        const uint32_t tail = _txTail;
+        const uint32_t index = _txIndex(tail);
+        const uint32_t toEnd = _txBufferSize - index;
+        const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
+
+        std::memcpy(data, &_txBuffer[index], first);
+        if (dataSize > first)
+            std::memcpy(data + first, &_txBuffer[0], dataSize - first);
+
+        streamStoreRelease(_txTail, _txAdvance(tail, dataSize));
+        _notifyWaiters();
+        return ret;
+    }
+
+    // LINEAR
+    // IMPORTANT: Do NOT write a '\0' terminator into the caller's output buffer.
+    // These APIs are byte-oriented (binary safe). The caller owns sizing/termination.
+    std::memcpy(data, &_txBuffer[_txTail], dataSize);
+
+    _txLinearRemove(dataSize);
+    _notifyWaiters();
+    return ret;
+}
+
+bool Stream::removeFrontTxBuffer(uint32_t dataSize)
+{
+    errorCode = STREAM_OK;
+    if (dataSize == 0) return true;
+
+    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    uint32_t avail = _isTxRing() ? _txRingAvailable(dataSize) : availableTx();
+    if (dataSize > avail) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    if (_txType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _txBipSnapshot(index1, len1, len2);
+        streamStoreRelease(_txTail, _bipNextTail(index1, len1, len2, dataSize));
+        _notifyWaiters();
+        return true;
+    }
+
+    if (_isTxRing())
+    {
+        const uint32_t tail = _txTail;
+        streamStoreRelease(_txTail, _txAdvance(tail, dataSize));
+        _notifyWaiters();
+        return true;
+    }
+
+    // LINEAR
+    _txLinearRemove(dataSize);
+    _notifyWaiters();
+    return true;
+}
+
+bool Stream::removeFrontRxBuffer(uint32_t dataSize)
+{
+    errorCode = STREAM_OK;
+    if (dataSize == 0) return true;
+
+    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    uint32_t avail = _isRxRing() ? _rxRingAvailable(dataSize) : availableRx();
+    if (dataSize > avail) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    if (_rxType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _rxBipSnapshot(index1, len1, len2);
+        _rxSetTail(_bipNextTail(index1, len1, len2, dataSize));
+        return true;
+    }
+
+    if (_isRxRing())
+    {
+        const uint32_t tail = _rxTail;
+        _rxSetTail(_rxAdvance(tail, dataSize));
+        return true;
+    }
+
+    // LINEAR
+    _rxLinearRemove(dataSize);
+    return true;
+}
+
+#if defined(_PLATFORM_PC_)
+    bool Stream::popFrontTxBuffer(std::string& out, uint32_t dataSize)
+    {
+        out.clear();
+        if (dataSize == 0)
+        {
+            errorCode = STREAM_ERR_SIZE_ZERO;
+            return false;
+        }
+
+        uint32_t avail = availableTx();
+        bool ret = true;
+        if (dataSize > avail)
+        {
+            dataSize = avail;
+            errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+            ret = false;
+        }
+
+        if (dataSize == 0) return ret; // nothing to pop
+
+        // temporary buffer
+        std::string tmp;
+        tmp.resize(dataSize);
+
+        if (!popFrontTxBuffer(&tmp[0], dataSize))
+            return false;
+
+        out.swap(tmp);
+        return ret;
+    }
+#endif
+
+bool Stream::popAllTxBuffer(char* data, uint32_t maxSize)
+{
+    return popFrontTxBuffer(data, maxSize);
+}
+
+#if defined(_PLATFORM_PC_)
+    bool Stream::popAllTxBuffer(std::string& data)
+    {
+        // works for linear + ring
+        return popFrontTxBuffer(data, availableTx());
+    }
+#endif
+
+bool Stream::popFrontRxBuffer(char* data, uint32_t dataSize)
+{
+    errorCode = STREAM_OK;
+
+    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    bool ret = true;
+    uint32_t avail = _isRxRing() ? _rxRingAvailable(dataSize) : availableRx();
+    if(dataSize > avail)
+    {
+        dataSize = avail;
         errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
         ret = false;
-        uint32_t need = dataSize - free;
-        if(need > _rxPosition) need = _rxPosition;
-        removeFrontRxBuffer(need);
     }
-    free = freeRx();
-    if (free < dataSize) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
 
-    std::memcpy(&_rxBuffer[_rxPosition], data, dataSize);
-    _rxPosition += dataSize;
-    _rxBuffer[_rxPosition] = '\0';
+    if (dataSize == 0) return ret;
+
+    if (_rxType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _rxBipSnapshot(index1, len1, len2);
+        const uint32_t first = (dataSize < len1) ? dataSize : len1;
+
+        std::memcpy(data, &_rxBuffer[index1], first);
+        if (dataSize > first)
+            std::memcpy(data + first, &_rxBuffer[0], dataSize - first);
+
+        _rxSetTail(_bipNextTail(index1, len1, len2, dataSize));
+        return ret;
+    }
+
+    if (_isRxRing())
+    {
+        const uint32_t tail = _rxTail;
+        const uint32_t index = _rxIndex(tail);
+        const uint32_t toEnd = _rxBufferSize - index;
+        const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
+
+        std::memcpy(data, &_rxBuffer[index], first);
+        if (dataSize > first)
+            std::memcpy(data + first, &_rxBuffer[0], dataSize - first);
+
+        _rxSetTail(_rxAdvance(tail, dataSize));
+        return ret;
+    }
+
+    // LINEAR
+    // IMPORTANT: Do NOT write a '\0' terminator into the caller's output buffer.
+    // These APIs are byte-oriented (binary safe). The caller owns sizing/termination.
+    std::memcpy(data, &_rxBuffer[_rxTail], dataSize);
+
+    _rxLinearRemove(dataSize);
     return ret;
 }
 
+bool Stream::popFrontRxBufferV(const StreamSpan* spans, uint32_t count)
+{
+    errorCode = STREAM_OK;
+
+    uint32_t total;
+    if (!_spansTotal(spans, count, total)) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (total == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    if (_rxType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _rxBipSnapshot(index1, len1, len2);
+        if (total > len1 + len2) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+
+        _scatterCopy(&_rxBuffer[index1], len1, &_rxBuffer[0], len2, spans, count);
+        _rxSetTail(_bipNextTail(index1, len1, len2, total));
+        return true;
+    }
+
+    if (_isRxRing())
+    {
+        if (total > _rxRingAvailable(total)) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+
+        const uint32_t tail = _rxTail;
+        const uint32_t index = _rxIndex(tail);
+        const uint32_t toEnd = _rxBufferSize - index;
+        const uint32_t first = (total < toEnd) ? total : toEnd;
+
+        _scatterCopy(&_rxBuffer[index], first, &_rxBuffer[0], total - first, spans, count);
+        _rxSetTail(_rxAdvance(tail, total));
+        return true;
+    }
+
+    // LINEAR
+    if (total > availableRx()) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+    _scatterCopy(&_rxBuffer[_rxTail], total, nullptr, 0, spans, count);
+    _rxLinearRemove(total);
+    return true;
+}
+
+bool Stream::popFrontTxBufferV(const StreamSpan* spans, uint32_t count)
+{
+    errorCode = STREAM_OK;
+
+    uint32_t total;
+    if (!_spansTotal(spans, count, total)) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (total == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    if (_txType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _txBipSnapshot(index1, len1, len2);
+        if (total > len1 + len2) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+
+        _scatterCopy(&_txBuffer[index1], len1, &_txBuffer[0], len2, spans, count);
+        streamStoreRelease(_txTail, _bipNextTail(index1, len1, len2, total));
+        _notifyWaiters();
+        return true;
+    }
+
+    if (_isTxRing())
+    {
+        if (total > _txRingAvailable(total)) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+
+        const uint32_t tail = _txTail;
+        const uint32_t index = _txIndex(tail);
+        const uint32_t toEnd = _txBufferSize - index;
+        const uint32_t first = (total < toEnd) ? total : toEnd;
+
+        _scatterCopy(&_txBuffer[index], first, &_txBuffer[0], total - first, spans, count);
+        streamStoreRelease(_txTail, _txAdvance(tail, total));
+        _notifyWaiters();
+        return true;
+    }
+
+    // LINEAR
+    if (total > availableTx()) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+    _scatterCopy(&_txBuffer[_txTail], total, nullptr, 0, spans, count);
+    _txLinearRemove(total);
+    _notifyWaiters();
+    return true;
+}
+
 #if defined(_PLATFORM_PC_)
-    bool Stream::pushBackTxBuffer(const std::string& data)
+    bool Stream::popFrontRxBuffer(std::string& out, uint32_t dataSize)
     {
-        return pushBackTxBuffer(data.c_str(), data.size());
+        out.clear();
+        if (dataSize == 0)
+        {
+            errorCode = STREAM_ERR_SIZE_ZERO;
+            return false;
+        }
+
+        uint32_t avail = availableRx();
+        bool ret = true;
+        if (dataSize > avail)
+        {
+            dataSize = avail;
+            errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+            ret = false;
+        }
+
+        if (dataSize == 0) return ret;
+
+        std::string tmp;
+        tmp.resize(dataSize);
+
+        if (!popFrontRxBuffer(&tmp[0], dataSize))
+            return false;
+
+        out.swap(tmp);
+        return ret;
     }
+#endif
 
-    bool Stream::pushBackRxBuffer(const std::string& data)
+bool Stream::popAllRxBuffer(char* data, uint32_t maxSize)
+{
+    return popFrontRxBuffer(data, maxSize);
+}
+
+#if defined(_PLATFORM_PC_)
+    bool Stream::popAllRxBuffer(std::string& data)
     {
-        return pushBackRxBuffer(data.c_str(), data.size());
+        return popFrontRxBuffer(data, availableRx());
     }
 #endif
 
-bool Stream::popFrontTxBuffer(char* data, uint32_t dataSize)
+uint32_t Stream::availableTx() const
+{
+    if (!_txBuffer || _txBufferSize < 2) return 0;
+
+    if (_txType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _txBipSnapshot(index1, len1, len2);
+        return len1 + len2;
+    }
+
+    if (_isTxRing())
+    {
+        // Snapshot tail stable against TX-complete ISR
+        uint32_t tail1, head;
+        _txSnapshot(head, tail1);
+
+        uint32_t used = _txUsed(head, tail1);
+        if (used > _txCapacity()) used = _txCapacity(); // paranoia clamp
+        return used;
+    }
+
+    return _txPosition - _txTail;
+}
+
+uint32_t Stream::availableRx() const
+{
+    if (!_rxBuffer || _rxBufferSize < 2) return 0;
+
+    if (_rxType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _rxBipSnapshot(index1, len1, len2);
+        return len1 + len2;
+    }
+
+    if (_isRxRing())
+    {
+        uint32_t tail1, head;
+        _rxSnapshot(head, tail1);
+
+        uint32_t used = _rxUsed(head, tail1);
+        if (used > _rxCapacity()) used = _rxCapacity();
+        return used;
+    }
+
+    return _rxPosition - _rxTail;
+}
+
+char Stream::peekRx(size_t index) const
+{
+    if (_rxBuffer == nullptr || _rxBufferSize < 2)
+        return 0;
+
+    uint32_t avail = availableRx();
+    if (index >= avail)
+        return 0;
+
+    if (_rxType == BUFFER_BIP)
+    {
+        uint32_t index1, len1, len2;
+        _rxBipSnapshot(index1, len1, len2);
+        return (index < len1) ? _rxBuffer[index1 + index] : _rxBuffer[index - len1];
+    }
+
+    if (_isRxRing())
+    {
+        uint32_t physicalIndex = _rxIndex(_rxAdvance(_rxTail, static_cast<uint32_t>(index)));
+        return _rxBuffer[physicalIndex];
+    }
+
+    return _rxBuffer[_rxTail + index];
+}
+
+size_t Stream::findRx(char delimiter) const
+{
+    // One snapshot, then memchr over the (at most two) contiguous segments
+    const char *seg1, *seg2;
+    uint32_t len1, len2;
+    if (!rxPeek(seg1, len1, seg2, len2))
+        return SIZE_MAX;
+
+    const void* hit = len1 ? std::memchr(seg1, delimiter, len1) : nullptr;
+    if (hit) return static_cast<size_t>(static_cast<const char*>(hit) - seg1);
+
+    hit = len2 ? std::memchr(seg2, delimiter, len2) : nullptr;
+    if (hit) return len1 + static_cast<size_t>(static_cast<const char*>(hit) - seg2);
+
+    return SIZE_MAX;
+}
+
+size_t Stream::findRx(const char* pattern, size_t patternSize) const
+{
+    if ((pattern == nullptr) || (patternSize == 0)) return SIZE_MAX;
+
+    if (patternSize == 1) return findRx(pattern[0]);
+
+    const char *seg1, *seg2;
+    uint32_t len1, len2;
+    if (!rxPeek(seg1, len1, seg2, len2))
+        return SIZE_MAX;
+
+    const size_t avail = static_cast<size_t>(len1) + len2;
+    if (patternSize > avail) return SIZE_MAX;
+
+    // Horspool bad-character table. Shifts are capped at 255 to keep the table
+    // 256 bytes on the stack; a shorter shift is always safe.
+    const size_t last = patternSize - 1;
+    uint8_t shift[256];
+    std::memset(shift, (patternSize > 255) ? 255 : static_cast<int>(patternSize), sizeof(shift));
+    for (size_t i = 0; i < last; ++i)
+    {
+        const size_t s = last - i;
+        shift[static_cast<uint8_t>(pattern[i])] = static_cast<uint8_t>((s > 255) ? 255 : s);
+    }
+
+    const char lastChar = pattern[last];
+    for (size_t pos = 0; pos + last < avail; )
+    {
+        const size_t end = pos + last;
+        const char c = (end < len1) ? seg1[end] : seg2[end - len1];
+
+        if (c == lastChar)
+        {
+            // Compare the remaining bytes, split at the wrap if the window spans it
+            bool match;
+            if (end < len1)
+                match = (std::memcmp(seg1 + pos, pattern, last) == 0);
+            else if (pos >= len1)
+                match = (std::memcmp(seg2 + (pos - len1), pattern, last) == 0);
+            else
+            {
+                const size_t head = len1 - pos;
+                match = (std::memcmp(seg1 + pos, pattern, head) == 0) &&
+                        (std::memcmp(seg2, pattern + head, last - head) == 0);
+            }
+
+            if (match) return pos;
+        }
+
+        pos += shift[static_cast<uint8_t>(c)];
+    }
+
+    return SIZE_MAX;
+}
+
+size_t Stream::findRxFrom(StreamScanCursor& cursor, char delimiter) const
+{
+    // Restart if bytes were consumed since the last call, or for another delimiter
+    if (cursor.epoch != _rxReadEpoch || cursor.delimiter != delimiter)
+    {
+        cursor.epoch = _rxReadEpoch;
+        cursor.delimiter = delimiter;
+        cursor.scanned = 0;
+    }
+
+    const char *seg1, *seg2;
+    uint32_t len1, len2;
+    if (!rxPeek(seg1, len1, seg2, len2))
+        return SIZE_MAX;
+
+    const uint32_t avail = len1 + len2;
+    if (cursor.scanned > avail) cursor.scanned = 0;
+
+    // Only scan the bytes that arrived since the last call
+    const void* hit = nullptr;
+    uint32_t from = cursor.scanned;
+    if (from < len1)
+    {
+        hit = std::memchr(seg1 + from, delimiter, len1 - from);
+        if (hit)
+        {
+            cursor.scanned = static_cast<uint32_t>(static_cast<const char*>(hit) - seg1);
+            return cursor.scanned;
+        }
+        from = len1;
+    }
+
+    if (from < avail)
+    {
+        hit = std::memchr(seg2 + (from - len1), delimiter, avail - from);
+        if (hit)
+        {
+            cursor.scanned = len1 + static_cast<uint32_t>(static_cast<const char*>(hit) - seg2);
+            return cursor.scanned;
+        }
+    }
+
+    cursor.scanned = avail;
+    return SIZE_MAX;
+}
+
+bool Stream::_findLine(const char* seg1, uint32_t len1, const char* seg2, uint32_t len2,
+                       StreamLineEnding ending, StreamLineView& line)
+{
+    const uint32_t avail = len1 + len2;
+    uint32_t from = 0;
+
+    while (from < avail)
+    {
+        // Next '\n' at or after from, in whichever segment it falls
+        uint32_t index;
+        const void* hit = nullptr;
+        if (from < len1)
+            hit = std::memchr(seg1 + from, '\n', len1 - from);
+        if (hit)
+            index = static_cast<uint32_t>(static_cast<const char*>(hit) - seg1);
+        else
+        {
+            const uint32_t start = (from > len1) ? (from - len1) : 0;
+            hit = (len2 > start) ? std::memchr(seg2 + start, '\n', len2 - start) : nullptr;
+            if (!hit) return false;
+            index = len1 + static_cast<uint32_t>(static_cast<const char*>(hit) - seg2);
+        }
+
+        const bool cr = (index > 0) && (((index - 1) < len1) ? seg1[index - 1] : seg2[index - 1 - len1]) == '\r';
+        if ((ending == STREAM_LINE_CRLF) && !cr)
+        {
+            from = index + 1;       // lone '\n' is part of the line
+            continue;
+        }
+
+        const uint32_t size = (cr && (ending != STREAM_LINE_LF)) ? (index - 1) : index;
+        const uint32_t size1 = (size < len1) ? size : len1;
+        line.seg1.data = seg1;
+        line.seg1.size = size1;
+        line.seg2.data = (size > size1) ? seg2 : nullptr;
+        line.seg2.size = size - size1;
+        line.frameSize = index + 1;
+        return true;
+    }
+
+    return false;
+}
+
+bool Stream::readLineRx(StreamLineView& line) const
+{
+    line = StreamLineView();
+
+    const char *seg1, *seg2;
+    uint32_t len1, len2;
+    if (!rxPeek(seg1, len1, seg2, len2))
+        return false;
+
+    return _findLine(seg1, len1, seg2, len2, _rxLineEnding, line);
+}
+
+uint32_t Stream::drainLinesRx(StreamLineCallback callback, void* context, uint32_t maxLines)
 {
     errorCode = STREAM_OK;
+    if (callback == nullptr) { errorCode = STREAM_ERR_PARAM; return 0; }
 
-    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
-    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
-    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+    // One snapshot for the whole batch
+    const char *seg1, *seg2;
+    uint32_t len1, len2;
+    if (!rxPeek(seg1, len1, seg2, len2))
+        return 0;
 
-    bool ret = true;
+    uint32_t lines = 0;
+    uint32_t consumed = 0;
+    StreamLineView line;
 
-    uint32_t avail = availableTx();
-    if (dataSize > avail) 
+    while ((maxLines == 0) || (lines < maxLines))
     {
-        dataSize = avail;
-        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; // Not enough data in the buffer to pop
-        ret = false;
+        // Remaining segments after the lines handled so far
+        const bool inSeg1 = (consumed < len1);
+        const char* cur1 = inSeg1 ? (seg1 + consumed) : (seg2 + (consumed - len1));
+        const uint32_t curLen1 = inSeg1 ? (len1 - consumed) : (len2 - (consumed - len1));
+
+        if (!_findLine(cur1, curLen1, inSeg1 ? seg2 : nullptr, inSeg1 ? len2 : 0, _rxLineEnding, line))
+            break;
+
+        ++lines;
+        consumed += line.frameSize;
+        if (!callback(line, context)) break;
     }
 
-    if (_txType == BUFFER_RING)
+    // One tail publication for the whole batch
+    if (consumed) rxConsume(consumed);
+    return lines;
+}
+
+size_t Stream::copyRxUntil(char delimiter, char* dst, size_t dstSize) const
+{
+    if (dst == nullptr || dstSize == 0)
+        return SIZE_MAX;
+
+    const char *seg1, *seg2;
+    uint32_t len1, len2;
+    if (!rxPeek(seg1, len1, seg2, len2) || (len1 + len2) == 0)
     {
-        const uint32_t tail = _txTail;
-        const uint32_t toEnd = _txBufferSize - tail;
-        const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
+        dst[0] = '\0';
+        return 0;
+    }
 
-        std::memcpy(data, &_txBuffer[tail], first);
-        if (dataSize > first)
-            std::memcpy(data + first, &_txBuffer[0], dataSize - first);
+    // Only the first dstSize bytes can hold a delimiter that fits
+    const uint32_t avail = len1 + len2;
+    const uint32_t scan = (avail < dstSize) ? avail : static_cast<uint32_t>(dstSize);
+    const uint32_t scan1 = (scan < len1) ? scan : len1;
 
-        STREAM_DMB();
-        _txTail = (tail + dataSize) % _txBufferSize;
-        return ret;
+    size_t index = SIZE_MAX;
+    const void* hit = scan1 ? std::memchr(seg1, delimiter, scan1) : nullptr;
+    if (hit) index = static_cast<size_t>(static_cast<const char*>(hit) - seg1);
+    else if (scan > scan1)
+    {
+        hit = std::memchr(seg2, delimiter, scan - scan1);
+        if (hit) index = len1 + static_cast<size_t>(static_cast<const char*>(hit) - seg2);
     }
 
-    // LINEAR
-    // IMPORTANT: Do NOT write a '\0' terminator into the caller's output buffer.
-    // These APIs are byte-oriented (binary safe). The caller owns sizing/termination.
-    std::memcpy(data, _txBuffer, dataSize);
+    const size_t toCopy = (index == SIZE_MAX) ? avail : index;
+    const uint32_t limit = static_cast<uint32_t>((toCopy < dstSize) ? toCopy : (dstSize - 1));
 
-    std::memmove(_txBuffer, _txBuffer + dataSize, _txPosition - dataSize);
-    _txPosition -= dataSize;
-    _txBuffer[_txPosition] = '\0';
-    return ret;
+    const StreamSpan out = { dst, limit };
+    _scatterCopy(seg1, len1, seg2, len2, &out, 1);
+    dst[limit] = '\0';
+
+    return (index == SIZE_MAX || toCopy >= dstSize) ? SIZE_MAX : index;
 }
 
-bool Stream::removeFrontTxBuffer(uint32_t dataSize)
+uint32_t Stream::reserveTx(uint32_t dataSize, char*& seg1, uint32_t& len1, char*& seg2, uint32_t& len2)
 {
     errorCode = STREAM_OK;
-    if (dataSize == 0) return true;
+    seg1 = seg2 = nullptr;
+    len1 = len2 = 0;
 
-    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (!_txBuffer || _txBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return 0; }
+    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return 0; }
+    if (_txType == BUFFER_RING_MPSC) { errorCode = STREAM_ERR_PARAM; return 0; }   // claims are per producer, see pushBackTxBuffer()
 
-    uint32_t avail = availableTx();
-    if (dataSize > avail) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (_txType == BUFFER_BIP)
+    {
+        // Contiguous or nothing: never split a reservation across the buffer end
+        uint32_t start;
+        _txBipReserved = 0;
+        if (!_txBipReserve(dataSize, start))
+        {
+            errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+            return 0;
+        }
 
-    if (_txType == BUFFER_RING)
+        _txBipStart = start;
+        _txBipReserved = dataSize;
+        seg1 = &_txBuffer[start];
+        len1 = dataSize;
+        return dataSize;
+    }
+
+    const uint32_t free = _isTxRing() ? _txRingFree(dataSize) : freeTx();
+    if (dataSize > free)
     {
-        const uint32_t tail = _txTail;
-        _txTail = (tail + dataSize) % _txBufferSize;
-        return true;
+        dataSize = free;
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+    }
+
+    if (dataSize == 0) return 0;
+
+    if (_isTxRing())
+    {
+        const uint32_t index = _txIndex(_txHead);
+        const uint32_t toEnd = _txBufferSize - index;
+
+        seg1 = &_txBuffer[index];
+        len1 = (dataSize < toEnd) ? dataSize : toEnd;
+        if (dataSize > len1)
+        {
+            seg2 = &_txBuffer[0];
+            len2 = dataSize - len1;
+        }
+        return dataSize;
     }
 
     // LINEAR
-    std::memmove(_txBuffer, _txBuffer + dataSize, _txPosition - dataSize);
-    _txPosition -= dataSize;
-    _txBuffer[_txPosition] = '\0';
-    return true;
+    _txLinearMakeRoom(dataSize);
+    seg1 = &_txBuffer[_txPosition];
+    len1 = dataSize;
+    return dataSize;
 }
 
-bool Stream::removeFrontRxBuffer(uint32_t dataSize)
+bool Stream::commitTx(uint32_t dataSize)
 {
     errorCode = STREAM_OK;
     if (dataSize == 0) return true;
 
-    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (!_txBuffer || _txBufferSize < 2 || _txType == BUFFER_RING_MPSC) { errorCode = STREAM_ERR_PARAM; return false; }
 
-    uint32_t avail = availableRx();
-    if (dataSize > avail) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (_txType == BUFFER_BIP)
+    {
+        if (dataSize > _txBipReserved) { errorCode = STREAM_ERR_PARAM; return false; }
+        _txBipPublish(_txBipStart, dataSize);
+        _txBipReserved = 0;
+        return true;
+    }
 
-    if (_rxType == BUFFER_RING)
+    if (_isTxRing())
     {
-        const uint32_t tail = _rxTail;
-        _rxTail = (tail + dataSize) % _rxBufferSize;
+        if (dataSize > _txRingFree(dataSize)) { errorCode = STREAM_ERR_PARAM; return false; }
+
+        const uint32_t head = _txHead;
+        streamStoreRelease(_txHead, _txAdvance(head, dataSize));
         return true;
     }
 
-    // LINEAR
-    std::memmove(_rxBuffer, _rxBuffer + dataSize, _rxPosition - dataSize);
-    _rxPosition -= dataSize;
-    _rxBuffer[_rxPosition] = '\0';
+    // LINEAR: only the space after the data is contiguous (LINEAR_LAZY may not be compacted yet)
+    if (dataSize > _txCapacity() - _txPosition) { errorCode = STREAM_ERR_PARAM; return false; }
+    _txPosition += dataSize;
+    _txBuffer[_txPosition] = '\0';
     return true;
 }
 
-#if defined(_PLATFORM_PC_)
-    bool Stream::popFrontTxBuffer(std::string& out, uint32_t dataSize)
-    {
-        out.clear();
-        if (dataSize == 0)
-        {
-            errorCode = STREAM_ERR_SIZE_ZERO;
-            return false;
-        }
+uint32_t Stream::reserveRx(uint32_t dataSize, char*& seg1, uint32_t& len1, char*& seg2, uint32_t& len2)
+{
+    errorCode = STREAM_OK;
+    seg1 = seg2 = nullptr;
+    len1 = len2 = 0;
 
-        uint32_t avail = availableTx();
-        bool ret = true;
-        if (dataSize > avail)
+    if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return 0; }
+    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return 0; }
+
+    if (_rxType == BUFFER_BIP)
+    {
+        // Contiguous or nothing: never split a reservation across the buffer end
+        uint32_t start;
+        _rxBipReserved = 0;
+        if (!_rxBipReserve(dataSize, start))
         {
-            dataSize = avail;
             errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
-            ret = false;
+            return 0;
         }
 
-        if (dataSize == 0) return ret; // nothing to pop
-
-        // temporary buffer
-        std::string tmp;
-        tmp.resize(dataSize);
+        _rxBipStart = start;
+        _rxBipReserved = dataSize;
+        seg1 = &_rxBuffer[start];
+        len1 = dataSize;
+        return dataSize;
+    }
 
-        if (!popFrontTxBuffer(&tmp[0], dataSize))
-            return false;
+    if (_rxReaderCount != 0) _rxReadersMakeRoom(dataSize);
 
-        out.swap(tmp);
-        return ret;
+    const uint32_t free = (_isRxRing() && _rxReaderCount == 0) ? _rxRingFree(dataSize) : freeRx();
+    if (dataSize > free)
+    {
+        dataSize = free;
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
     }
-#endif
 
-bool Stream::popAllTxBuffer(char* data, uint32_t maxSize)
-{
-    return popFrontTxBuffer(data, maxSize);
-}
+    if (dataSize == 0) return 0;
 
-#if defined(_PLATFORM_PC_)
-    bool Stream::popAllTxBuffer(std::string& data)
+    if (_isRxRing())
     {
-        // works for linear + ring
-        return popFrontTxBuffer(data, availableTx());
+        const uint32_t index = _rxIndex(_rxHead);
+        const uint32_t toEnd = _rxBufferSize - index;
+
+        seg1 = &_rxBuffer[index];
+        len1 = (dataSize < toEnd) ? dataSize : toEnd;
+        if (dataSize > len1)
+        {
+            seg2 = &_rxBuffer[0];
+            len2 = dataSize - len1;
+        }
+        return dataSize;
     }
-#endif
 
-bool Stream::popFrontRxBuffer(char* data, uint32_t dataSize)
+    // LINEAR
+    _rxLinearMakeRoom(dataSize);
+    seg1 = &_rxBuffer[_rxPosition];
+    len1 = dataSize;
+    return dataSize;
+}
+
+bool Stream::commitRx(uint32_t dataSize)
 {
     errorCode = STREAM_OK;
+    if (dataSize == 0) return true;
 
-    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
-    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
     if (!_rxBuffer || _rxBufferSize < 2) { errorCode = STREAM_ERR_PARAM; return false; }
 
-    bool ret = true;
-    uint32_t avail = availableRx();
-    if(dataSize > avail)
+    if (_rxType == BUFFER_BIP)
     {
-        dataSize = avail;
-        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
-        ret = false;
+        if (dataSize > _rxBipReserved) { errorCode = STREAM_ERR_PARAM; return false; }
+        _rxBipPublish(_rxBipStart, dataSize);
+        _rxBipReserved = 0;
+        _notifyWaiters();
+        return true;
     }
 
-    if (dataSize == 0) return ret;
-
-    if (_rxType == BUFFER_RING)
+    if (_isRxRing())
     {
-        const uint32_t tail = _rxTail;
-        const uint32_t toEnd = _rxBufferSize - tail;
-        const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
+        const uint32_t free = (_rxReaderCount == 0) ? _rxRingFree(dataSize) : freeRx();
+        if (dataSize > free) { errorCode = STREAM_ERR_PARAM; return false; }
 
-        std::memcpy(data, &_rxBuffer[tail], first);
-        if (dataSize > first)
-            std::memcpy(data + first, &_rxBuffer[0], dataSize - first);
-
-        STREAM_DMB();
-        _rxTail = (tail + dataSize) % _rxBufferSize;
-        return ret;
+        const uint32_t head = _rxHead;
+        streamStoreRelease(_rxHead, _rxAdvance(head, dataSize));
+        _notifyWaiters();
+        return true;
     }
 
-    // LINEAR
-    // IMPORTANT: Do NOT write a '\0' terminator into the caller's output buffer.
-    // These APIs are byte-oriented (binary safe). The caller owns sizing/termination.
-    std::memcpy(data, _rxBuffer, dataSize);
-
-    std::memmove(_rxBuffer, _rxBuffer + dataSize, _rxPosition - dataSize);
-    _rxPosition -= dataSize;
+    // LINEAR: only the space after the data is contiguous (LINEAR_LAZY may not be compacted yet)
+    if (dataSize > _rxCapacity() - _rxPosition) { errorCode = STREAM_ERR_PARAM; return false; }
+    _rxPosition += dataSize;
     _rxBuffer[_rxPosition] = '\0';
-    return ret;
+    _notifyWaiters();
+    return true;
 }
 
-#if defined(_PLATFORM_PC_)
-    bool Stream::popFrontRxBuffer(std::string& out, uint32_t dataSize)
+uint32_t Stream::splice(Stream& src, StreamDirection srcDir, Stream& dst, StreamDirection dstDir, uint32_t maxBytes)
+{
+    dst.errorCode = STREAM_OK;
+    if ((&src == &dst) && (srcDir == dstDir)) { dst.errorCode = STREAM_ERR_PARAM; return 0; }
+
+    const bool dstOk = (dstDir == STREAM_TX) ? (dst._txBuffer && dst._txBufferSize >= 2)
+                                             : (dst._rxBuffer && dst._rxBufferSize >= 2);
+    if (!dstOk) { dst.errorCode = STREAM_ERR_PARAM; return 0; }
+
+    // Source: readable segments (consumer side)
+    StreamConstSpan from[2];
+    const char* seg1;
+    const char* seg2;
+    const bool srcOk = (srcDir == STREAM_RX) ? src.rxPeek(seg1, from[0].size, seg2, from[1].size)
+                                             : src._txPeek(seg1, from[0].size, seg2, from[1].size);
+    if (!srcOk) { dst.errorCode = STREAM_ERR_PARAM; return 0; }
+    from[0].data = seg1;
+    from[1].data = seg2;
+
+    uint32_t offered = from[0].size + from[1].size;
+    if (offered > maxBytes) offered = maxBytes;
+    if (offered == 0) return 0;
+
+    // Destination: copy into free segments, publish once
+    uint32_t moved;
+    if (dstDir == STREAM_TX && dst._txType == BUFFER_RING_MPSC)
     {
-        out.clear();
-        if (dataSize == 0)
+        moved = dst._txMpscPush(from, 2, offered, true);
+    }
+    else
+    {
+        const uint32_t free = (dstDir == STREAM_TX) ? dst.freeTx() : dst.freeRx();
+        const uint32_t n = (offered < free) ? offered : free;
+
+        char* d1 = nullptr;
+        char* d2 = nullptr;
+        uint32_t dlen1 = 0, dlen2 = 0;
+        moved = 0;
+        if (n != 0)
         {
-            errorCode = STREAM_ERR_SIZE_ZERO;
-            return false;
+            moved = (dstDir == STREAM_TX) ? dst.reserveTx(n, d1, dlen1, d2, dlen2)
+                                          : dst.reserveRx(n, d1, dlen1, d2, dlen2);
         }
 
-        uint32_t avail = availableRx();
-        bool ret = true;
-        if (dataSize > avail)
+        if (moved != 0)
         {
-            dataSize = avail;
-            errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
-            ret = false;
+            _gatherCopy(d1, dlen1, d2, dlen2, from, 2);
+            if (dstDir == STREAM_TX) dst.commitTx(moved);
+            else dst.commitRx(moved);
         }
-
-        if (dataSize == 0) return ret;
-
-        std::string tmp;
-        tmp.resize(dataSize);
-
-        if (!popFrontRxBuffer(&tmp[0], dataSize))
-            return false;
-
-        out.swap(tmp);
-        return ret;
     }
-#endif
 
-bool Stream::popAllRxBuffer(char* data, uint32_t maxSize)
-{
-    return popFrontRxBuffer(data, maxSize);
-}
-
-#if defined(_PLATFORM_PC_)
-    bool Stream::popAllRxBuffer(std::string& data)
+    // Source: release the moved bytes once
+    if (moved != 0)
     {
-        return popFrontRxBuffer(data, availableRx());
+        if (srcDir == STREAM_RX) src.rxConsume(moved);
+        else src.removeFrontTxBuffer(moved);
     }
-#endif
 
-uint32_t Stream::availableTx() const
+    dst.errorCode = (moved < offered) ? STREAM_ERR_OVERFLOW_OR_SHORT : STREAM_OK;
+    return moved;
+}
+
+#if STREAM_MAX_RX_READERS > 0
+int8_t Stream::attachRxReader()
 {
-    if (!_txBuffer || _txBufferSize < 2) return 0;
+    errorCode = STREAM_OK;
 
-    if (_txType == BUFFER_RING)
+    if (!_rxBuffer || _rxBufferSize < 2 || !_isRxRing()) { errorCode = STREAM_ERR_PARAM; return -1; }
+
+    for (uint8_t id = 0; id < STREAM_MAX_RX_READERS; ++id)
     {
-        // Snapshot tail stable against TX-complete ISR
-        uint32_t tail1, tail2, head;
-        do
-        {
-            tail1 = _txTail;
-            head  = _txHead;
-            tail2 = _txTail;
-        } while (tail1 != tail2);
+        // Claim the slot (0 -> 2) so concurrent attach calls never get the same id; the producer
+        // and the reader functions ignore it until it is published as attached (1).
+        uint32_t state = 0;
+        if (!_atomicCas(_rxReaderAttached[id], state, 2)) continue;
 
-        uint32_t used = (head >= tail1) ? (head - tail1) : (_txBufferSize - (tail1 - head));
-        if (used >= _txBufferSize) used = _txBufferSize - 1; // paranoia clamp
-        return used;
+        _rxReaderTail[id] = streamLoadAcquire(_rxHead);     // new readers only see data that arrives after attaching
+        _rxReaderDropped[id] = 0;
+        streamStoreRelease(_rxReaderAttached[id], 1);
+        _atomicAddFetch(_rxReaderCount, 1);
+        return static_cast<int8_t>(id);
     }
 
-    return _txPosition;
+    errorCode = STREAM_ERR_PARAM;   // no free reader slot
+    return -1;
 }
 
-uint32_t Stream::availableRx() const
+bool Stream::detachRxReader(uint8_t id)
 {
-    if (!_rxBuffer || _rxBufferSize < 2) return 0;
+    errorCode = STREAM_OK;
+    if ((id >= STREAM_MAX_RX_READERS) || !_rxDetachReader(id)) { errorCode = STREAM_ERR_PARAM; return false; }
+    return true;
+}
 
-    if (_rxType == BUFFER_RING)
-    {
-        uint32_t tail1, tail2, head;
-        do
-        {
-            tail1 = _rxTail;
-            head  = _rxHead;
-            tail2 = _rxTail;
-        } while (tail1 != tail2);
+bool Stream::isRxReaderAttached(uint8_t id) const
+{
+    return (id < STREAM_MAX_RX_READERS) && (streamLoadAcquire(_rxReaderAttached[id]) == 1);
+}
 
-        uint32_t used = (head >= tail1) ? (head - tail1) : (_rxBufferSize - (tail1 - head));
-        if (used >= _rxBufferSize) used = _rxBufferSize - 1;
-        return used;
-    }
+uint32_t Stream::availableRxReader(uint8_t id) const
+{
+    if (!isRxReaderAttached(id)) return 0;
+    return _rxUsed(_rxHead, _rxReaderTail[id]);
+}
 
-    return _rxPosition;
+uint32_t Stream::getRxReaderDropped(uint8_t id) const
+{
+    return (id < STREAM_MAX_RX_READERS) ? streamLoadAcquire(_rxReaderDropped[id]) : 0u;
 }
 
-char Stream::peekRx(size_t index) const
+bool Stream::rxReaderPeek(uint8_t id, const char*& seg1, uint32_t& len1, const char*& seg2, uint32_t& len2) const
 {
-    if (_rxBuffer == nullptr || _rxBufferSize < 2)
-        return 0;
+    seg1 = seg2 = nullptr;
+    len1 = len2 = 0;
 
-    uint32_t avail = availableRx();
-    if (index >= avail)
-        return 0;
+    if (!isRxReaderAttached(id)) return false;
+
+    const uint32_t tail = _rxReaderTail[id];
+    const uint32_t head = _rxHead;
+    const uint32_t used = _rxUsed(head, tail);
+    if (used == 0) return true;
+
+    const uint32_t index = _rxIndex(tail);
+    const uint32_t toEnd = _rxBufferSize - index;
 
-    if (_rxType == BUFFER_RING)
+    seg1 = &_rxBuffer[index];
+    len1 = (used < toEnd) ? used : toEnd;
+    if (used > len1)
     {
-        uint32_t physicalIndex = (_rxTail + static_cast<uint32_t>(index)) % _rxBufferSize;
-        return _rxBuffer[physicalIndex];
+        seg2 = &_rxBuffer[0];
+        len2 = used - len1;
     }
-
-    return _rxBuffer[index];
+    return true;
 }
 
-size_t Stream::findRx(char delimiter) const
+bool Stream::rxReaderConsume(uint8_t id, uint32_t dataSize)
 {
-    if (_rxBuffer == nullptr || _rxBufferSize < 2)
-        return SIZE_MAX;
+    errorCode = STREAM_OK;
+    if (!isRxReaderAttached(id)) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (dataSize == 0) return true;
 
-    uint32_t avail = availableRx();
-    for (size_t i = 0; i < avail; ++i)
+    uint32_t tail = _rxReaderTail[id];
+    if (dataSize > _rxUsed(_rxHead, tail)) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    STREAM_DMB();
+    if (!_atomicCas(_rxReaderTail[id], tail, _rxAdvance(tail, dataSize)))
     {
-        if (peekRx(i) == delimiter)
-            return i;
+        // The producer dropped bytes for this lagging reader meanwhile (STREAM_READER_DROP)
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        return false;
     }
-
-    return SIZE_MAX;
+    return true;
 }
 
-size_t Stream::copyRxUntil(char delimiter, char* dst, size_t dstSize) const
+bool Stream::popFrontRxReader(uint8_t id, char* data, uint32_t dataSize)
 {
-    if (dst == nullptr || dstSize == 0)
-        return SIZE_MAX;
+    errorCode = STREAM_OK;
 
-    uint32_t avail = availableRx();
-    if (avail == 0)
+    if (data == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+    if (dataSize == 0) { errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (!isRxReaderAttached(id)) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    uint32_t tail = _rxReaderTail[id];
+    const uint32_t used = _rxUsed(_rxHead, tail);
+    if (dataSize > used) { errorCode = STREAM_ERR_OVERFLOW_OR_SHORT; return false; }
+
+    const uint32_t index = _rxIndex(tail);
+    const uint32_t toEnd = _rxBufferSize - index;
+    const uint32_t first = (dataSize < toEnd) ? dataSize : toEnd;
+
+    std::memcpy(data, &_rxBuffer[index], first);
+    if (dataSize > first)
+        std::memcpy(data + first, &_rxBuffer[0], dataSize - first);
+
+    STREAM_DMB();
+    if (!_atomicCas(_rxReaderTail[id], tail, _rxAdvance(tail, dataSize)) || (_rxReaderAttached[id] != 1))
     {
-        dst[0] = '\0';
-        return 0;
+        // Overrun while copying: the producer dropped or detached this reader, data may be stale
+        errorCode = STREAM_ERR_OVERFLOW_OR_SHORT;
+        return false;
+    }
+    return true;
+}
+
+uint32_t Stream::_rxReadersMaxUsed(uint32_t head) const
+{
+    uint32_t maxUsed = 0;
+    for (uint8_t id = 0; id < STREAM_MAX_RX_READERS; ++id)
+    {
+        if (streamLoadAcquire(_rxReaderAttached[id]) != 1) continue;     // free or being attached
+        const uint32_t used = _rxUsed(head, _rxReaderTail[id]);
+        if (used > maxUsed) maxUsed = used;
     }
+    return maxUsed;
+}
+
+void Stream::_rxReadersMakeRoom(uint32_t dataSize)
+{
+    if (_rxReaderPolicy == STREAM_READER_BLOCK) return;
 
-    size_t copied = 0;
+    const uint32_t head = _rxHead;
+    const uint32_t cap = _rxCapacity();
+    if (dataSize > cap) dataSize = cap;
 
-    for (size_t i = 0; i < avail; ++i)
+    for (uint8_t id = 0; id < STREAM_MAX_RX_READERS; ++id)
     {
-        char c = peekRx(i);
+        if (streamLoadAcquire(_rxReaderAttached[id]) != 1) continue;     // free or being attached
 
-        if (c == delimiter)
-        {
-            if (copied < dstSize)
-                dst[copied] = '\0';
-            else
-                dst[dstSize - 1] = '\0';
+        uint32_t tail = _rxReaderTail[id];
+        uint32_t used = _rxUsed(head, tail);
+        if (used + dataSize <= cap) continue;
 
-            return copied;
+        if (_rxReaderPolicy == STREAM_READER_DETACH)
+        {
+            _rxDetachReader(id);
+            continue;
         }
 
-        if (copied + 1 >= dstSize)
+        // STREAM_READER_DROP: skip the oldest bytes of this reader only
+        uint32_t drop = used + dataSize - cap;
+        while (!_atomicCas(_rxReaderTail[id], tail, _rxAdvance(tail, drop)))
         {
-            dst[dstSize - 1] = '\0';
-            return SIZE_MAX;
+            used = _rxUsed(head, tail);     // reader consumed meanwhile
+            if (used + dataSize <= cap) { drop = 0; break; }
+            drop = used + dataSize - cap;
         }
-
-        dst[copied++] = c;
+        streamStoreRelease(_rxReaderDropped[id], _rxReaderDropped[id] + drop);    // producer is the only writer
     }
+}
 
-    dst[copied < dstSize ? copied : dstSize - 1] = '\0';
-    return SIZE_MAX;
+bool Stream::_rxDetachReader(uint8_t id)
+{
+    // Reader context and producer (STREAM_READER_DETACH) may race: only one of them wins.
+    uint32_t attached = 1;
+    if (!_atomicCas(_rxReaderAttached[id], attached, 0)) return false;
+    _atomicAddFetch(_rxReaderCount, static_cast<uint32_t>(-1));
+    return true;
+}
+
+void Stream::_detachAllRxReaders()
+{
+    for (uint8_t id = 0; id < STREAM_MAX_RX_READERS; ++id) _rxReaderAttached[id] = 0;
+    _rxReaderCount = 0;
+}
+#else
+// RX readers compiled out (STREAM_MAX_RX_READERS == 0): _rxReaderCount stays 0.
+int8_t Stream::attachRxReader() { errorCode = STREAM_ERR_PARAM; return -1; }
+bool Stream::detachRxReader(uint8_t) { errorCode = STREAM_ERR_PARAM; return false; }
+bool Stream::isRxReaderAttached(uint8_t) const { return false; }
+uint32_t Stream::availableRxReader(uint8_t) const { return 0; }
+uint32_t Stream::getRxReaderDropped(uint8_t) const { return 0; }
+
+bool Stream::rxReaderPeek(uint8_t, const char*& seg1, uint32_t& len1, const char*& seg2, uint32_t& len2) const
+{
+    seg1 = seg2 = nullptr;
+    len1 = len2 = 0;
+    return false;
 }
+
+bool Stream::rxReaderConsume(uint8_t, uint32_t) { errorCode = STREAM_ERR_PARAM; return false; }
+bool Stream::popFrontRxReader(uint8_t, char*, uint32_t) { errorCode = STREAM_ERR_PARAM; return false; }
+uint32_t Stream::_rxReadersMaxUsed(uint32_t) const { return 0; }
+void Stream::_rxReadersMakeRoom(uint32_t) {}
+bool Stream::_rxDetachReader(uint8_t) { return false; }
+void Stream::_detachAllRxReaders() {}
+#endif
@@ -22,6 +22,8 @@
  * @warning Concurrency / ISR note:
  * - If one context writes (ISR) and another reads (main loop), protect shared state
  *   or design as single-producer/single-consumer with careful access rules.
+ * - On host builds head/tail are std::atomic with acquire/release ordering, so one producer
+ *   thread and one consumer thread per direction are safe (see STREAM_USE_STD_ATOMIC).
  */
 
 // ####################################################################################################
@@ -34,6 +36,9 @@
 
 #if defined(_PLATFORM_PC_)
     #include <string>   // Provides the std::string class for working with dynamic strings in C++
+    #include <mutex>                // Blocking waits (waitRxAvailable(), waitTxFree(), ...)
+    #include <condition_variable>
+    #include <atomic>
 #endif
 
 // ###################################################################################################
@@ -54,6 +59,134 @@
   #endif
 #endif
 
+// -------------------------------------------------------------------------------------------------
+// Index backend for head/tail and the other shared counters.
+// 1: std::atomic<uint32_t> with acquire/release ordering (C++11). Needed for correct multi-threaded
+//    use on hosts, where STREAM_DMB() is a no-op and the compiler may reorder plain accesses.
+// 0: volatile uint32_t fenced by STREAM_DMB() (single-core MCU, ISR <-> main loop).
+// Defaults to 1 on host builds. You can override it before including Stream.h.
+// -------------------------------------------------------------------------------------------------
+#ifndef STREAM_USE_STD_ATOMIC
+  #if defined(_PLATFORM_PC_)
+    #define STREAM_USE_STD_ATOMIC 1
+  #else
+    #define STREAM_USE_STD_ATOMIC 0
+  #endif
+#endif
+
+#if STREAM_USE_STD_ATOMIC
+    #include <atomic>
+
+    /// @brief Shared index/counter type (see STREAM_USE_STD_ATOMIC).
+    typedef std::atomic<uint32_t> StreamIndex;
+
+    /// @brief Read an index written by the other side (acquire: its data writes are visible afterwards).
+    inline uint32_t streamLoadAcquire(const StreamIndex& index) { return index.load(std::memory_order_acquire); }
+
+    /// @brief Read an index owned by the calling side (no ordering needed, only its own writes).
+    inline uint32_t streamLoadRelaxed(const StreamIndex& index) { return index.load(std::memory_order_relaxed); }
+
+    /// @brief Publish an index (release: all previous buffer reads/writes complete before it is seen).
+    inline void streamStoreRelease(StreamIndex& index, uint32_t value) { index.store(value, std::memory_order_release); }
+#else
+    typedef volatile uint32_t StreamIndex;
+
+    inline uint32_t streamLoadAcquire(const StreamIndex& index) { return index; }
+
+    inline uint32_t streamLoadRelaxed(const StreamIndex& index) { return index; }
+
+    inline void streamStoreRelease(StreamIndex& index, uint32_t value)
+    {
+        STREAM_DMB();
+        index = value;
+    }
+#endif
+
+// -------------------------------------------------------------------------------------------------
+// Cache-line isolation of producer and consumer state (multicore hosts).
+// 1: producer-owned and consumer-owned fields of each direction start on separate cache lines,
+//    so a producer thread and a consumer thread on different cores do not false-share the
+//    head/tail line. Costs a few cache lines of RAM per Stream and makes Stream over-aligned
+//    (allocate it statically, on the stack, or with C++17 aligned new).
+// 0: compact layout (default; no benefit on single-core MCUs).
+// You can override both before including Stream.h.
+// -------------------------------------------------------------------------------------------------
+#ifndef STREAM_ISOLATE_CACHE_LINES
+  #define STREAM_ISOLATE_CACHE_LINES 0
+#endif
+
+#ifndef STREAM_CACHE_LINE_SIZE
+  #define STREAM_CACHE_LINE_SIZE 64
+#endif
+
+#if STREAM_ISOLATE_CACHE_LINES
+  #define STREAM_CACHE_ALIGN alignas(STREAM_CACHE_LINE_SIZE)
+#else
+  #define STREAM_CACHE_ALIGN
+#endif
+
+// -------------------------------------------------------------------------------------------------
+// Maximum number of additional RX readers (see Stream::attachRxReader()).
+// Each reader slot costs 12 bytes of RAM. 0 removes the reader support (attachRxReader() always fails).
+// You can override it before including Stream.h.
+// -------------------------------------------------------------------------------------------------
+#ifndef STREAM_MAX_RX_READERS
+  #define STREAM_MAX_RX_READERS 2
+#endif
+
+// -------------------------------------------------------------------------------------------------
+// Multi-producer TX ring (BUFFER_RING_MPSC).
+// 1: enabled (default).
+// 0: removed; a BUFFER_RING_MPSC TX type is refused like on RX (error code 1, single-producer ring kept).
+// You can override it before including Stream.h.
+// -------------------------------------------------------------------------------------------------
+#ifndef STREAM_ENABLE_MPSC
+  #define STREAM_ENABLE_MPSC 1
+#endif
+
+// -------------------------------------------------------------------------------------------------
+// BUFFER_RING_MPSC: maximum number of producers inside pushBackTxBuffer() at the same time.
+// Each writer slot costs 8 bytes of RAM. An extra producer waits for a free slot (host threads yield),
+// so on a single core use at least the number of contexts (main loop + ISR priorities) that push.
+// You can override it before including Stream.h.
+// -------------------------------------------------------------------------------------------------
+#ifndef STREAM_MPSC_MAX_WRITERS
+  #define STREAM_MPSC_MAX_WRITERS 4
+#endif
+
+// -------------------------------------------------------------------------------------------------
+// Atomic read-modify-write (compare-and-swap, add) is only needed by BUFFER_RING_MPSC and the RX
+// readers; everything else uses plain loads and stores. Backends, in order of preference:
+// std::atomic (STREAM_USE_STD_ATOMIC), GCC/clang __atomic builtins, MSVC Interlocked functions, or
+// a PRIMASK critical section (STREAM_ATOMIC_IRQ_LOCK) where the first ones are not available:
+// ARMCC5, and ARMv6-M cores (Cortex-M0/M0+) which have no LDREX/STREX.
+// The PRIMASK backend is only correct between ISRs and the main loop of a single core.
+// -------------------------------------------------------------------------------------------------
+#define STREAM_ATOMIC_RMW (STREAM_ENABLE_MPSC || (STREAM_MAX_RX_READERS > 0))
+
+#ifndef STREAM_ATOMIC_IRQ_LOCK
+  #if STREAM_ATOMIC_RMW && !STREAM_USE_STD_ATOMIC && (defined(__CC_ARM) || \
+      ((defined(__arm__) || defined(__thumb__)) && !defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)))
+    #define STREAM_ATOMIC_IRQ_LOCK 1
+  #else
+    #define STREAM_ATOMIC_IRQ_LOCK 0
+  #endif
+#endif
+
+// -------------------------------------------------------------------------------------------------
+// Timeout value that makes the blocking waits (host builds) wait without limit.
+// -------------------------------------------------------------------------------------------------
+#define STREAM_WAIT_FOREVER 0xFFFFFFFFU
+
+// -------------------------------------------------------------------------------------------------
+// First sleep of a blocking wait, in milliseconds. Producers check for waiters without a fence,
+// so a publish that races with a waiter registering may not wake it; the waiter rechecks after
+// this time and sleeps until notified afterwards. You can override it before including Stream.h.
+// -------------------------------------------------------------------------------------------------
+#ifndef STREAM_WAIT_RECHECK_MS
+  #define STREAM_WAIT_RECHECK_MS 1
+#endif
+
 // ###################################################################################################
 // Buffer type selection
 
@@ -64,18 +197,180 @@
  * - BUFFER_LINEAR:
  *   Data always starts at index 0. Removing from front uses `memmove()` to shift.
  *
+ * - BUFFER_LINEAR_LAZY:
+ *   Linear buffer with a read offset. Removing from front only advances the offset;
+ *   data is moved back to index 0 when a push would not fit otherwise, when the buffer
+ *   drains, or on demand with compactTxBuffer()/compactRxBuffer().
+ *   Popping a buffer a few bytes at a time is O(n) instead of O(n^2).
+ *
  * - BUFFER_RING:
  *   Circular buffer with head/tail indices. Removing from front does NOT use memmove.
  *
- * @note In ring mode, effective capacity is (bufferSize - 1) bytes.
+ * - BUFFER_RING_POW2:
+ *   Same as BUFFER_RING, but the buffer size must be a power of two so index wrapping
+ *   uses a bit mask instead of `%` (no software divide on Cortex-M0/M3).
+ *   If the size is not a power of two, the buffer falls back to BUFFER_RING and
+ *   errorCode is set to STREAM_ERR_PARAM.
+ *
+ * - BUFFER_RING_FULL:
+ *   Ring buffer whose head/tail are free-running 32-bit counters (physical index is
+ *   `counter & (bufferSize - 1)`). Every byte of the buffer is usable and full/empty
+ *   checks are plain `head - tail` with no wrap ambiguity.
+ *   The buffer size must be a power of two (same fallback rule as BUFFER_RING_POW2).
+ *   No '\0' terminator is kept in this mode.
+ *
+ * - BUFFER_BIP:
+ *   Bipartite buffer. Every write (pushBack/reserve) gets one contiguous region or is
+ *   refused; a write that does not fit before the buffer end restarts at index 0 and the
+ *   skipped tail space is marked by a watermark. Frames never straddle the buffer end,
+ *   so a DMA engine always gets each frame in one transfer.
+ *   freeTx()/freeRx() report the largest contiguous writable block in this mode; an empty
+ *   buffer restarts at index 0, so it always offers its full size in one block.
+ *
+ * - BUFFER_RING_MPSC (TX only):
+ *   BUFFER_RING_FULL layout that accepts pushBackTxBuffer() from several producers at once
+ *   (threads, or ISRs of different priorities). Each producer claims space with an atomic
+ *   compare-and-swap, copies its bytes, then publishes the head up to the oldest region still
+ *   being copied, so the single consumer sees every message whole and in claim order, and a
+ *   stalled producer only holds back the bytes claimed after its own.
+ *   Needs a power-of-two size (see also STREAM_MPSC_MAX_WRITERS and STREAM_ATOMIC_RMW).
+ *   reserveTx()/commitTx() are not available in this mode.
+ *   Requested for RX, it falls back to BUFFER_RING_FULL (or BUFFER_RING) with STREAM_ERR_PARAM.
+ *
+ * @note In BUFFER_RING/BUFFER_RING_POW2 mode, effective capacity is (bufferSize - 1) bytes.
  *       One byte is reserved so you can keep a '\0' terminator for string compatibility.
+ *       In BUFFER_RING_FULL/BUFFER_RING_MPSC mode, effective capacity is bufferSize bytes.
  */
 enum BufferType : uint8_t 
 {
-    BUFFER_LINEAR = 0,      ///< Linear buffer (memmove on pop/remove)
-    BUFFER_RING   = 1       ///< Ring buffer (head/tail, no memmove)
+    BUFFER_LINEAR    = 0,   ///< Linear buffer (memmove on pop/remove)
+    BUFFER_RING      = 1,   ///< Ring buffer (head/tail, no memmove)
+    BUFFER_RING_POW2 = 2,   ///< Ring buffer with power-of-two size (mask indexing)
+    BUFFER_RING_FULL = 3,   ///< Full-capacity ring with free-running head/tail counters (power-of-two size)
+    BUFFER_BIP       = 4,   ///< Bipartite buffer (contiguous writes, watermark wrap)
+    BUFFER_LINEAR_LAZY = 5, ///< Linear buffer with read offset (compacts lazily)
+    BUFFER_RING_MPSC = 6    ///< Multi-producer TX ring (free-running counters, power-of-two size)
+};
+
+/**
+ * @enum StreamReaderPolicy
+ * @brief What the RX producer does when an attached reader lags and the new data does not fit.
+ *
+ * The main RX reader (popFrontRxBuffer(), rxPeek(), ...) always holds back the producer.
+ * The policy only applies to readers added with Stream::attachRxReader().
+ */
+enum StreamReaderPolicy : uint8_t
+{
+    STREAM_READER_BLOCK  = 0,   ///< Lagging readers hold back the producer (write is refused, even with STREAM_OVERFLOW_DROP_OLDEST)
+    STREAM_READER_DROP   = 1,   ///< Skip the oldest bytes of the lagging reader (counted in getRxReaderDropped())
+    STREAM_READER_DETACH = 2    ///< Detach the lagging reader
 };
 
+/**
+ * @enum StreamOverflowPolicy
+ * @brief What pushBackTxBuffer()/pushBackRxBuffer() do when the data does not fit.
+ *
+ * Every overflow returns false with error code 2 and is counted in the drop statistics
+ * (see Stream::getTxDroppedBytes(), Stream::getTxDropEvents()).
+ *
+ * STREAM_OVERFLOW_DROP_OLDEST on a ring buffer is not lock-free: the producer writes the
+ * consumer's state (tail and cached indices). The consumer must be quiescent while the producer
+ * pushes, e.g. a disabled consumer ISR, a stopped DMA channel, or producer and consumer in the
+ * same context or under a common lock. A consumer that runs concurrently (ISR, DMA, other thread)
+ * can read stale or half-evicted data; use REJECT, DROP_NEWEST or PARTIAL in that case.
+ */
+enum StreamOverflowPolicy : uint8_t
+{
+    STREAM_OVERFLOW_AUTO        = 0,    ///< Legacy behaviour: DROP_OLDEST for linear buffers; rings keep the last capacity bytes of a larger message, then REJECT if it does not fit; REJECT otherwise
+    STREAM_OVERFLOW_REJECT      = 1,    ///< Write nothing (all bytes counted as dropped)
+    STREAM_OVERFLOW_DROP_OLDEST = 2,    ///< Evict the oldest buffered bytes to make room (producer moves the tail: consumer must be quiescent, see above)
+    STREAM_OVERFLOW_DROP_NEWEST = 3,    ///< Write the part that fits, discard the rest (counted as dropped)
+    STREAM_OVERFLOW_PARTIAL     = 4     ///< Write the part that fits, the caller keeps the rest (not counted as dropped)
+};
+
+/**
+ * @enum StreamDirection
+ * @brief Selects the TX or RX buffer of a Stream (see Stream::splice()).
+ */
+enum StreamDirection : uint8_t
+{
+    STREAM_TX = 0,
+    STREAM_RX = 1
+};
+
+/**
+ * @enum StreamLineEnding
+ * @brief Line terminator of Stream::readLineRx() and Stream::drainLinesRx() (see Stream::setRxLineEnding()).
+ */
+enum StreamLineEnding : uint8_t
+{
+    STREAM_LINE_LF   = 0,   ///< Lines end at '\n' (a '\r' before it stays in the line)
+    STREAM_LINE_CRLF = 1,   ///< Lines end at "\r\n" only (a lone '\n' stays in the line)
+    STREAM_LINE_ANY  = 2    ///< Lines end at '\n'; a '\r' before it is stripped from the line
+};
+
+/**
+ * @struct StreamConstSpan
+ * @brief One source fragment for the gather writes (Stream::pushBackTxBufferV()).
+ */
+struct StreamConstSpan
+{
+    const char* data;   ///< fragment bytes (may be nullptr if size is 0)
+    uint32_t size;      ///< fragment length in bytes
+};
+
+/**
+ * @struct StreamSpan
+ * @brief One destination buffer for the scatter reads (Stream::popFrontRxBufferV()).
+ */
+struct StreamSpan
+{
+    char* data;         ///< destination bytes (may be nullptr if size is 0)
+    uint32_t size;      ///< number of bytes to fill
+};
+
+/**
+ * @struct StreamScanCursor
+ * @brief Resume state for Stream::findRxFrom().
+ *
+ * Remembers how many RX bytes were already searched for the delimiter. It is reset
+ * automatically when RX bytes are consumed or another delimiter is searched.
+ */
+struct StreamScanCursor
+{
+    uint32_t epoch = 0;         ///< RX read epoch of the last scan
+    uint32_t scanned = 0;       ///< bytes (from the RX read position) already searched
+    char delimiter = 0;         ///< delimiter of the last scan
+
+    /// @brief Forget the scan progress.
+    void reset() { epoch = 0; scanned = 0; delimiter = 0; }
+};
+
+/**
+ * @struct StreamLineView
+ * @brief One RX line returned by Stream::readLineRx(), in place in the RX buffer.
+ *
+ * The line (without terminator) is seg1 followed by seg2; seg2 is only used when the
+ * line wraps the ring end. The view stays valid until the line is consumed.
+ */
+struct StreamLineView
+{
+    StreamConstSpan seg1 = {nullptr, 0};    ///< first part of the line
+    StreamConstSpan seg2 = {nullptr, 0};    ///< rest of the line after a ring wrap
+    uint32_t frameSize = 0;                 ///< line length including the terminator (bytes to consume)
+
+    /// @brief Line length without the terminator.
+    uint32_t size() const { return seg1.size + seg2.size; }
+};
+
+/**
+ * @brief Line handler of Stream::drainLinesRx().
+ * @param line The line, in place in the RX buffer (valid only during the call).
+ * @param context User pointer passed to drainLinesRx().
+ * @return true to continue with the next line, false to stop after this one.
+ */
+typedef bool (*StreamLineCallback)(const StreamLineView& line, void* context);
+
 // ###################################################################################################
 // Data type enumaration and value union :
 
@@ -495,6 +790,7 @@ void dataValueToString(char *str, const dataValueUnion& value, const dataTypeEnu
  * ## Capacity rule
  * For safety and optional '\0' termination, the effective capacity is:
  * - capacity = (bufferSize - 1)
+ * - capacity = bufferSize for BUFFER_RING_FULL (no terminator byte).
  *
  * This means if bufferSize == 0 or 1, the buffer cannot store data.
  */
@@ -539,6 +835,8 @@ public:
      * @param txType Buffer mode (linear/ring).
      *
      * @note For storing any data, txBufferSize must be >= 2 (capacity is txBufferSize-1).
+     * @note For BUFFER_RING_POW2, BUFFER_RING_FULL and BUFFER_RING_MPSC, txBufferSize must be a power of two. Otherwise the
+     *       buffer falls back to BUFFER_RING and errorCode is STREAM_ERR_PARAM.
      */
     void setTxBuffer(char* txBuffer, uint32_t txBufferSize, BufferType txType = BUFFER_LINEAR);
 
@@ -591,12 +889,28 @@ public:
      *
      * @note This does NOT point to “first valid data” in ring mode.
      *       Use rxReadPtr() for that purpose.
+     * @note In BUFFER_LINEAR_LAZY mode, call compactRxBuffer() first to get the data
+     *       as a '\0' terminated C-string at the buffer start.
      */
     const char* getRxBuffer() const;
 
+    /**
+     * @brief Move buffered TX data to the buffer start (linear modes).
+     * @return TX buffer base pointer holding the data as a '\0' terminated string, or nullptr.
+     *
+     * In BUFFER_LINEAR_LAZY mode this applies the pending read offset. In BUFFER_LINEAR
+     * mode data is already at the start and nothing is moved.
+     * @note - Error code be 1 if: "TX buffer not configured or not a linear buffer type"
+     */
+    const char* compactTxBuffer();
+
+    /// @copydoc compactTxBuffer()
+    const char* compactRxBuffer();
+
     /**
      * @brief Pointer to first valid TX byte (read position).
-     * @return In ring mode: &txBuffer[tail]. In linear mode: txBuffer base.
+     * @return In ring mode: &txBuffer[tail]. In BUFFER_LINEAR_LAZY mode: txBuffer + read offset.
+     *         In linear mode: txBuffer base.
      *
      * @note In ring mode, data may wrap. Use txContiguousSize() to know how many bytes
      *       are contiguous from this pointer before wrapping to the buffer start.
@@ -626,6 +940,27 @@ public:
      */
     bool txPeekContiguous(const char*& ptr, uint32_t& len) const;
 
+    /**
+     * @brief Atomically (lock-free) snapshot all readable RX data as up to two segments.
+     * @param[out] seg1 First readable segment (at the read position), or nullptr if empty.
+     * @param[out] len1 Length of seg1.
+     * @param[out] seg2 Second readable segment (buffer start after a ring wrap), or nullptr.
+     * @param[out] len2 Length of seg2.
+     * @return false if the RX buffer is not configured.
+     *
+     * Parsers can work in place on the segments and release bytes later with rxConsume().
+     * Bytes stay valid until they are consumed.
+     */
+    bool rxPeek(const char*& seg1, uint32_t& len1, const char*& seg2, uint32_t& len2) const;
+
+    /**
+     * @brief Release bytes previously inspected with rxPeek().
+     * @param dataSize Number of bytes to consume from the RX read position.
+     * @return true if succeeded.
+     * @note - Error code be 1 if: "Not enough data in the buffer to consume"
+     */
+    bool rxConsume(uint32_t dataSize);
+
     /**
      * @brief Number of contiguous valid bytes from rxReadPtr().
      *
@@ -636,7 +971,8 @@ public:
 
     /**
      * @brief Bytes free for writing (without overflow).
-     * @note Effective capacity is (bufferSize - 1).
+     * @note Effective capacity is (bufferSize - 1), or bufferSize in BUFFER_RING_FULL mode.
+     * @note In BUFFER_BIP mode this is the largest contiguous block that can be reserved.
      */
     uint32_t freeTx() const;
 
@@ -685,7 +1021,7 @@ public:
      * @param dataSize is the data length for push back.
      * @return true if succeeded.
      * @note - Error code be 1 if: "Error Stream: data can not be null."
-     * @note - Error code be 2 if: "Error Stream: TX Buffer Overflow"
+     * @note - Error code be 2 if: "Error Stream: TX Buffer Overflow" (handled by setTxOverflowPolicy())
      */
     bool pushBackTxBuffer(const char* data, uint32_t dataSize = 1);
 
@@ -706,10 +1042,28 @@ public:
      * @param dataSize is the data length for push back.
      * @return true if succeeded.
      * @note - Error code be 1 if: "Error Stream: data can not be null."
-     * @note - Error code be 2 if: "Error Stream: RX Buffer Overflow"
+     * @note - Error code be 2 if: "Error Stream: RX Buffer Overflow" (handled by setRxOverflowPolicy())
      */
     bool pushBackRxBuffer(const char* data, uint32_t dataSize = 1);
 
+    /**
+     * @brief Push back several fragments (e.g. header, payload, CRC) as one write into TxBuffer.
+     * @param spans Fragments, appended in order.
+     * @param count Number of fragments.
+     * @return true if all fragments were written.
+     *
+     * Free space is checked once and the write position is published once, so the consumer
+     * never sees a partial frame. The write is all-or-nothing: the overflow policy is not
+     * applied, a frame that does not fit is rejected and counted in the drop statistics.
+     * @note - Error code be 1 if: "spans is null, a non-empty fragment has null data, or TX buffer invalid"
+     * @note - Error code be 2 if: "Not enough free space"
+     * @note - Error code be 3 if: "Total size is zero"
+     */
+    bool pushBackTxBufferV(const StreamConstSpan* spans, uint32_t count);
+
+    /// @copydoc pushBackTxBufferV()
+    bool pushBackRxBufferV(const StreamConstSpan* spans, uint32_t count);
+
     #if defined(_PLATFORM_PC_)
         /**
          * @brief Push back certain number charecter in to RxBuffer.
@@ -759,6 +1113,23 @@ public:
      *  */
     bool popFrontRxBuffer(char* data, uint32_t dataSize = 1);
 
+    /**
+     * @brief Pop the next bytes of RX buffer into several destination buffers (scatter pop).
+     * @param spans Destination buffers, filled in order (e.g. a header struct, then the payload).
+     * @param count Number of destination buffers.
+     * @return true if all buffers were filled.
+     *
+     * Availability is checked once and the read position is published once. The pop is
+     * all-or-nothing: if fewer bytes than the total span size are buffered, nothing is removed.
+     * @note - Error code be 1 if: "spans is null, a non-empty span has null data, or RX buffer invalid"
+     * @note - Error code be 2 if: "Not enough data in the buffer to pop"
+     * @note - Error code be 3 if: "Total size is zero"
+     */
+    bool popFrontRxBufferV(const StreamSpan* spans, uint32_t count);
+
+    /// @copydoc popFrontRxBufferV()
+    bool popFrontTxBufferV(const StreamSpan* spans, uint32_t count);
+
     #if defined(_PLATFORM_PC_)
         /**
          * @brief Pop all elements from front of TX buffer and remove them.
@@ -821,6 +1192,31 @@ public:
      */
     size_t findRx(char delimiter) const;
 
+    /**
+     * @brief Find the first occurrence of a multi-byte pattern in the RX buffer.
+     * @param pattern Bytes to search for (e.g. "\r\n", "+OK" or "\xAA\x55").
+     * @param patternSize Number of bytes in pattern.
+     * @return Logical index from RX tail of the first pattern byte, or SIZE_MAX if not found.
+     *
+     * Uses Boyer-Moore-Horspool directly on the two ring segments, so matches that span
+     * the wrap are found without copying the buffer out. A nullptr or empty pattern
+     * returns SIZE_MAX.
+     */
+    size_t findRx(const char* pattern, size_t patternSize) const;
+
+    /**
+     * @brief findRx() that resumes where the previous call with the same cursor stopped.
+     * @param cursor Scan state kept by the caller between polls (one cursor per parser).
+     * @param delimiter Character to search for.
+     * @return Logical index from RX tail, or SIZE_MAX if not found yet.
+     *
+     * Polling a slowly filling buffer costs O(new bytes) instead of O(buffered bytes).
+     * Consuming RX bytes (pop, remove, rxConsume, clear, overflow eviction) invalidates
+     * the cursor, so the next call scans again from the read position.
+     * @note Main RX reader only (not the readers added with attachRxReader()).
+     */
+    size_t findRxFrom(StreamScanCursor& cursor, char delimiter) const;
+
     /**
      * @brief Copy RX data until a delimiter is found, excluding the delimiter.
      * @param delimiter Stop character.
@@ -830,6 +1226,230 @@ public:
      */
     size_t copyRxUntil(char delimiter, char* dst, size_t dstSize) const;
 
+    /**
+     * @brief Zero-copy view of the next complete RX line.
+     * @param[out] line Line segments (terminator excluded) and the size to consume.
+     * @return true if a complete line is buffered, false otherwise (line is cleared).
+     *
+     * The terminator is selected with setRxLineEnding(). Nothing is consumed; call
+     * consumeLineRx() when done with the line.
+     * @note In BUFFER_LINEAR mode consuming still memmoves; use a ring or BUFFER_LINEAR_LAZY.
+     */
+    bool readLineRx(StreamLineView& line) const;
+
+    /**
+     * @brief Release the line returned by readLineRx() (terminator included).
+     * @return true if succeeded.
+     * @note - Error code be 1 if: "Not enough data in the buffer to consume" (see rxConsume())
+     */
+    bool consumeLineRx(const StreamLineView& line) { return rxConsume(line.frameSize); }
+
+    /**
+     * @brief Hand every complete RX line to a callback, then consume them all at once.
+     * @param callback Called once per line (see StreamLineCallback).
+     * @param context User pointer passed to the callback.
+     * @param maxLines Maximum number of lines to handle (0 = all buffered lines).
+     * @return Number of lines handled (and consumed).
+     *
+     * Takes one RX snapshot and publishes one tail update at the end, so the per-line
+     * cost is only the terminator search. Lines arriving during the call are left for
+     * the next call. The callback must not read or consume RX data of this Stream.
+     * @note - Error code be 1 if: "callback is nullptr"
+     */
+    uint32_t drainLinesRx(StreamLineCallback callback, void* context, uint32_t maxLines = 0);
+
+    /// @brief Select the line terminator of readLineRx() (default STREAM_LINE_LF).
+    void setRxLineEnding(StreamLineEnding ending) { _rxLineEnding = ending; }
+
+    /// @brief Return the line terminator of readLineRx().
+    StreamLineEnding getRxLineEnding() const { return _rxLineEnding; }
+
+    /**
+     * @brief Reserve writable space in the TX buffer (zero-copy producer, phase 1).
+     * @param[in]  dataSize Number of bytes the producer wants to write.
+     * @param[out] seg1 First writable segment (at the current write position).
+     * @param[out] len1 Length of seg1.
+     * @param[out] seg2 Second writable segment (buffer start after a ring wrap), or nullptr.
+     * @param[out] len2 Length of seg2.
+     * @return Total reserved bytes (len1 + len2) = min(dataSize, freeTx()).
+     *
+     * The producer formats/DMAs directly into the segments, then publishes with commitTx().
+     * Nothing is visible to the consumer until commitTx() is called.
+     *
+     * In BUFFER_BIP mode the reservation is all-or-nothing and always contiguous
+     * (seg2 is nullptr): either dataSize bytes are returned in seg1, or 0 with error code 2.
+     * @note - Error code be 3 if: "dataSize is zero"
+     * @note - Error code be 2 if: "Less than dataSize bytes free" (partial reservation)
+     * @note - Error code be 1 if: "TX buffer not configured"
+     */
+    uint32_t reserveTx(uint32_t dataSize, char*& seg1, uint32_t& len1, char*& seg2, uint32_t& len2);
+
+    /**
+     * @brief Publish bytes written into a reserveTx() reservation (zero-copy producer, phase 2).
+     * @param dataSize Number of bytes actually written (<= reserved bytes).
+     * @return true if succeeded.
+     * @note - Error code be 1 if: "dataSize exceeds free space" (linear modes: the contiguous space after the data)
+     */
+    bool commitTx(uint32_t dataSize);
+
+    /// @copydoc reserveTx()
+    uint32_t reserveRx(uint32_t dataSize, char*& seg1, uint32_t& len1, char*& seg2, uint32_t& len2);
+
+    /// @copydoc commitTx()
+    bool commitRx(uint32_t dataSize);
+
+    /**
+     * @brief Move buffered bytes from one Stream buffer to another without an intermediate copy.
+     * @param src Source stream.
+     * @param srcDir Source buffer (e.g. STREAM_RX of a USB stream).
+     * @param dst Destination stream (may be src with the other direction, e.g. RX -> TX loopback).
+     * @param dstDir Destination buffer (e.g. STREAM_TX of a UART stream).
+     * @param maxBytes Maximum number of bytes to move.
+     * @return Number of bytes moved.
+     *
+     * Bytes are copied straight from the source segments into the destination free segments
+     * (at most four memcpy), then the destination is published and the source consumed once each.
+     * Bytes that do not fit stay in the source. Call it from the consumer context of the source
+     * and the producer context of the destination. Error codes are reported in dst.errorCode.
+     * @note - Error code be 1 if: "Same buffer as source and destination, or a buffer is invalid"
+     * @note - Error code be 2 if: "Destination had less free space than the bytes offered"
+     */
+    static uint32_t splice(Stream& src, StreamDirection srcDir, Stream& dst, StreamDirection dstDir, uint32_t maxBytes);
+
+    /**
+     * @brief Attach an additional RX reader with its own read position (broadcast RX).
+     * @return Reader id (0 .. STREAM_MAX_RX_READERS-1), or -1 on failure.
+     *
+     * Every reader sees every byte received after it attached, without duplicated
+     * pushBackRxBuffer() calls. Free RX space is computed from the slowest reader
+     * (the main reader included); see setRxReaderPolicy() for lagging readers.
+     * @note Supported for BUFFER_RING, BUFFER_RING_POW2 and BUFFER_RING_FULL RX buffers.
+     * @note Changing the RX buffer or buffer type detaches all readers.
+     * @note Several threads may attach and detach readers at the same time (slots are claimed atomically).
+     * @note - Error code be 1 if: "RX buffer is not a ring buffer, or no free reader slot"
+     */
+    int8_t attachRxReader();
+
+    /**
+     * @brief Detach an RX reader added with attachRxReader().
+     * @return true if succeeded.
+     * @note - Error code be 1 if: "Reader is not attached"
+     */
+    bool detachRxReader(uint8_t id);
+
+    /// @brief Return true if the reader id is attached.
+    bool isRxReaderAttached(uint8_t id) const;
+
+    /// @brief Set what the producer does with lagging attached readers.
+    void setRxReaderPolicy(StreamReaderPolicy policy) { _rxReaderPolicy = policy; }
+
+    /// @brief Return the lagging reader policy.
+    StreamReaderPolicy getRxReaderPolicy() const { return _rxReaderPolicy; }
+
+    /// @brief Number of bytes available for the reader id (0 if not attached).
+    uint32_t availableRxReader(uint8_t id) const;
+
+    /// @brief Number of bytes skipped for the reader id by STREAM_READER_DROP since it attached.
+    uint32_t getRxReaderDropped(uint8_t id) const;
+
+    /**
+     * @brief rxPeek() for an attached reader.
+     * @return false if the reader is not attached.
+     */
+    bool rxReaderPeek(uint8_t id, const char*& seg1, uint32_t& len1, const char*& seg2, uint32_t& len2) const;
+
+    /**
+     * @brief rxConsume() for an attached reader.
+     * @return true if succeeded.
+     * @note - Error code be 1 if: "Reader not attached, or not enough data to consume"
+     * @note - Error code be 2 if: "Producer dropped bytes for this reader meanwhile" (peek again)
+     */
+    bool rxReaderConsume(uint8_t id, uint32_t dataSize);
+
+    /**
+     * @brief popFrontRxBuffer() for an attached reader (all-or-nothing).
+     * @return true if succeeded.
+     * @note - Error code be 1 if: "data is null or reader not attached"
+     * @note - Error code be 2 if: "Not enough data, or overrun while copying" (data is not valid)
+     * @note - Error code be 3 if: "dataSize is zero"
+     */
+    bool popFrontRxReader(uint8_t id, char* data, uint32_t dataSize);
+
+    /**
+     * @brief Set the TX overflow policy of pushBackTxBuffer().
+     * @note STREAM_OVERFLOW_DROP_OLDEST moves the tail from the producer side: the consumer must
+     * not run while the producer pushes (see StreamOverflowPolicy). It behaves as
+     * STREAM_OVERFLOW_REJECT for BUFFER_BIP and BUFFER_RING_MPSC.
+     */
+    void setTxOverflowPolicy(StreamOverflowPolicy policy) { _txOverflowPolicy = policy; }
+
+    /// @copydoc setTxOverflowPolicy()
+    void setRxOverflowPolicy(StreamOverflowPolicy policy) { _rxOverflowPolicy = policy; }
+
+    /// @brief Return the TX overflow policy.
+    StreamOverflowPolicy getTxOverflowPolicy() const { return _txOverflowPolicy; }
+
+    /// @brief Return the RX overflow policy.
+    StreamOverflowPolicy getRxOverflowPolicy() const { return _rxOverflowPolicy; }
+
+    /// @brief Number of bytes lost by TX overflows since the last resetTxDropStats().
+    uint32_t getTxDroppedBytes() const { return _txDroppedBytes; }
+
+    /// @brief Number of bytes lost by RX overflows since the last resetRxDropStats().
+    uint32_t getRxDroppedBytes() const { return _rxDroppedBytes; }
+
+    /// @brief Number of TX overflow events since the last resetTxDropStats().
+    uint32_t getTxDropEvents() const { return _txDropEvents; }
+
+    /// @brief Number of RX overflow events since the last resetRxDropStats().
+    uint32_t getRxDropEvents() const { return _rxDropEvents; }
+
+    /// @brief Clear the TX drop counters.
+    void resetTxDropStats();
+
+    /// @brief Clear the RX drop counters.
+    void resetRxDropStats();
+
+    /**
+     * @brief Number of bytes written by the last pushBackTxBuffer() call.
+     * @note Use it with STREAM_OVERFLOW_PARTIAL to resume the write with the remaining bytes.
+     */
+    uint32_t getTxLastPushSize() const { return _txLastPushSize; }
+
+    /// @copydoc getTxLastPushSize()
+    uint32_t getRxLastPushSize() const { return _rxLastPushSize; }
+
+    #if defined(_PLATFORM_PC_)
+        /**
+         * @brief Block until at least dataSize bytes are available in the RX buffer.
+         * @param timeoutMs Timeout in milliseconds (0: no wait, STREAM_WAIT_FOREVER: no limit).
+         * @return true if the data is available.
+         * @note Producers only signal when a thread is waiting (one relaxed load otherwise), so the
+         *       non-blocking API keeps its lock-free path. See STREAM_WAIT_RECHECK_MS.
+         * @note - Error code be 1 if: "RX buffer is invalid or dataSize exceeds the RX capacity"
+         * @note - Error code be 2 if: "Timeout"
+         */
+        bool waitRxAvailable(uint32_t dataSize, uint32_t timeoutMs);
+
+        /**
+         * @brief Block until the delimiter is in the RX buffer (see findRx()).
+         * @param timeoutMs Timeout in milliseconds (0: no wait, STREAM_WAIT_FOREVER: no limit).
+         * @return true if the delimiter was found.
+         * @note - Error code be 1 if: "RX buffer is invalid"
+         * @note - Error code be 2 if: "Timeout"
+         */
+        bool waitRxDelimiter(char delimiter, uint32_t timeoutMs);
+
+        /**
+         * @brief Block until at least dataSize bytes are free in the TX buffer.
+         * @param timeoutMs Timeout in milliseconds (0: no wait, STREAM_WAIT_FOREVER: no limit).
+         * @return true if the space is free.
+         * @note - Error code be 1 if: "TX buffer is invalid or dataSize exceeds the TX capacity"
+         * @note - Error code be 2 if: "Timeout"
+         */
+        bool waitTxFree(uint32_t dataSize, uint32_t timeoutMs);
+    #endif
+
 private:
 
     /// @brief TX buffer base pointer
@@ -844,22 +1464,335 @@ private:
     /// @brief RX buffer allocated size (bytes)
     uint32_t _rxBufferSize = 0;
 
-    /// @brief Linear mode: length of valid TX data
+    // Buffer type selection
+    BufferType _txType = BUFFER_LINEAR;
+    BufferType _rxType = BUFFER_LINEAR;
+
+    /// @brief BUFFER_RING_POW2/BUFFER_RING_FULL/BUFFER_RING_MPSC: (bufferSize - 1) index mask, otherwise 0
+    uint32_t _txMask = 0;
+
+    /// @brief BUFFER_RING_POW2/BUFFER_RING_FULL: (bufferSize - 1) index mask, otherwise 0
+    uint32_t _rxMask = 0;
+
+    // Overflow policy and reader policy (configuration, read-mostly)
+    StreamOverflowPolicy _txOverflowPolicy = STREAM_OVERFLOW_AUTO;
+    StreamOverflowPolicy _rxOverflowPolicy = STREAM_OVERFLOW_AUTO;
+    StreamReaderPolicy _rxReaderPolicy = STREAM_READER_BLOCK;
+    StreamLineEnding _rxLineEnding = STREAM_LINE_LF;
+
+    // The state below is grouped by the side that writes it. With STREAM_ISOLATE_CACHE_LINES each
+    // group starts on its own cache line. Ring-buffer state is only used when type is a ring type;
+    // BUFFER_LINEAR_LAZY uses the tail as read offset (always 0 in BUFFER_LINEAR).
+    // BUFFER_RING/BUFFER_RING_POW2: physical indices in [0, bufferSize).
+    // BUFFER_RING_FULL: free-running counters (physical index = counter & mask).
+
+    // ---- TX producer ----
+    STREAM_CACHE_ALIGN StreamIndex _txHead{0};     ///< written by producer only
+    uint32_t _txTailCache = 0;             ///< ring: producer's copy of _txTail (see _txRingFree())
+
+    /// @brief Linear mode: end of valid TX data
     uint32_t _txPosition = 0;
 
-    /// @brief Linear mode: length of valid RX data
+    StreamIndex _txWatermark{0};           ///< bip: end of valid data before a wrap (written by producer only)
+    uint32_t _txBipStart = 0;              ///< bip: start index of the pending reserveTx() region
+    uint32_t _txBipReserved = 0;           ///< bip: size of the pending reserveTx() region
+
+    #if STREAM_ENABLE_MPSC
+        // Multi-producer TX state (only used when type == BUFFER_RING_MPSC)
+        StreamIndex _txClaim{0};               ///< claimed (reserved) TX counter, ahead of or equal to _txHead
+        StreamIndex _txWriterActive[STREAM_MPSC_MAX_WRITERS] = {};    ///< 1 while a producer owns the slot
+        StreamIndex _txWriterStart[STREAM_MPSC_MAX_WRITERS] = {};     ///< claim counter the slot owner is claiming from
+    #endif
+
+    // TX drop accounting (see StreamOverflowPolicy)
+    StreamIndex _txDroppedBytes{0};        ///< updated with atomic add (several TX producers in BUFFER_RING_MPSC)
+    StreamIndex _txDropEvents{0};
+    uint32_t _txLastPushSize = 0;          ///< bytes written by the last pushBackTxBuffer()
+
+    // ---- TX consumer ----
+    STREAM_CACHE_ALIGN StreamIndex _txTail{0};     ///< written by consumer only (bip: also by the producer, only while empty)
+    uint32_t _txHeadCache = 0;             ///< ring: consumer's copy of _txHead (see _txRingAvailable())
+
+    // ---- RX producer ----
+    STREAM_CACHE_ALIGN StreamIndex _rxHead{0};     ///< written by producer only
+    uint32_t _rxTailCache = 0;             ///< ring: producer's copy of _rxTail (see _rxRingFree())
+
+    /// @brief Linear mode: end of valid RX data
     uint32_t _rxPosition = 0;
 
-    // Buffer type selection
-    BufferType _txType = BUFFER_LINEAR;
-    BufferType _rxType = BUFFER_LINEAR;
+    StreamIndex _rxWatermark{0};           ///< bip: end of valid data before a wrap (written by producer only)
+    uint32_t _rxBipStart = 0;              ///< bip: start index of the pending reserveRx() region
+    uint32_t _rxBipReserved = 0;           ///< bip: size of the pending reserveRx() region
+
+    // RX drop accounting
+    StreamIndex _rxDroppedBytes{0};
+    StreamIndex _rxDropEvents{0};
+    uint32_t _rxLastPushSize = 0;          ///< bytes written by the last pushBackRxBuffer()
+
+    // ---- RX consumer ----
+    STREAM_CACHE_ALIGN StreamIndex _rxTail{0};     ///< written by consumer only (bip: also by the producer, only while empty)
+    uint32_t _rxHeadCache = 0;             ///< ring: consumer's copy of _rxHead (see _rxRingAvailable())
+    uint32_t _rxReadEpoch = 0;             ///< bumped whenever the RX read position moves (see findRxFrom())
+
+    // ---- Broadcast RX readers (see attachRxReader()) ----
+    #if STREAM_MAX_RX_READERS > 0
+        STREAM_CACHE_ALIGN StreamIndex _rxReaderTail[STREAM_MAX_RX_READERS] = {};  ///< per-reader tail (reader, or producer with STREAM_READER_DROP)
+        StreamIndex _rxReaderAttached[STREAM_MAX_RX_READERS] = {};         ///< 0 free, 2 being attached, 1 attached
+        StreamIndex _rxReaderDropped[STREAM_MAX_RX_READERS] = {};          ///< bytes skipped by STREAM_READER_DROP (written by producer only)
+    #endif
+    StreamIndex _rxReaderCount{0};                                     ///< attached readers (fast path check, always 0 without readers)
+
+    #if defined(_PLATFORM_PC_)
+        // Blocking waits (host builds only)
+        STREAM_CACHE_ALIGN std::mutex _waitMutex;
+        std::condition_variable _waitCond;
+        std::atomic<uint32_t> _waiters{0};     ///< threads blocked in a wait function
+    #endif
+
+    /// @brief Return true if value is a non-zero power of two.
+    static bool _isPowerOfTwo(uint32_t value);
+
+    /**
+     * @brief Set TX buffer type and index mask for the current TX buffer size.
+     * @return false if BUFFER_RING_POW2/BUFFER_RING_FULL was requested for a non power-of-two size (falls back to BUFFER_RING).
+     */
+    bool _applyTxType(BufferType txType);
+
+    /// @copydoc _applyTxType()
+    bool _applyRxType(BufferType rxType);
+
+    /// @brief True if TX uses head/tail ring indexing.
+    bool _isTxRing() const { return (_txType == BUFFER_RING) || (_txType == BUFFER_RING_POW2) || _isTxFreeRunning(); }
+
+    /// @brief True if TX head/tail are free-running counters.
+    bool _isTxFreeRunning() const { return (_txType == BUFFER_RING_FULL) || (_txType == BUFFER_RING_MPSC); }
 
-    // Ring-buffer state (only used when type == BUFFER_RING)
-    volatile uint32_t _txHead = 0;     ///< written by producer only
-    volatile uint32_t _txTail = 0;     ///< written by consumer only
+    /// @brief True if RX uses head/tail ring indexing.
+    bool _isRxRing() const { return (_rxType == BUFFER_RING) || (_rxType == BUFFER_RING_POW2) || (_rxType == BUFFER_RING_FULL); }
 
-    volatile uint32_t _rxHead = 0;     ///< written by producer only
-    volatile uint32_t _rxTail = 0;     ///< written by consumer only
+    /// @brief Wrap a TX ring index into [0, bufferSize). Mask in BUFFER_RING_POW2, modulo otherwise.
+    uint32_t _txWrap(uint32_t index) const { return _txMask ? (index & _txMask) : (index % _txBufferSize); }
+
+    /// @brief Wrap an RX ring index into [0, bufferSize). Mask in BUFFER_RING_POW2, modulo otherwise.
+    uint32_t _rxWrap(uint32_t index) const { return _rxMask ? (index & _rxMask) : (index % _rxBufferSize); }
+
+    /// @brief Physical TX buffer index of a head/tail value (masks free-running counters).
+    uint32_t _txIndex(uint32_t index) const { return _txMask ? (index & _txMask) : index; }
+
+    /// @brief Physical RX buffer index of a head/tail value (masks free-running counters).
+    uint32_t _rxIndex(uint32_t index) const { return _rxMask ? (index & _rxMask) : index; }
+
+    /// @brief Advance a TX head/tail value by n bytes (counters run free in BUFFER_RING_FULL/BUFFER_RING_MPSC).
+    uint32_t _txAdvance(uint32_t index, uint32_t n) const { return _isTxFreeRunning() ? (index + n) : _txWrap(index + n); }
+
+    /// @brief Advance an RX head/tail value by n bytes (counters run free in BUFFER_RING_FULL).
+    uint32_t _rxAdvance(uint32_t index, uint32_t n) const { return (_rxType == BUFFER_RING_FULL) ? (index + n) : _rxWrap(index + n); }
+
+    /// @brief Used TX ring bytes for a head/tail snapshot.
+    uint32_t _txUsed(uint32_t head, uint32_t tail) const
+    {
+        if (_isTxFreeRunning()) return head - tail;
+        return (head >= tail) ? (head - tail) : (_txBufferSize - (tail - head));
+    }
+
+    /// @brief Used RX ring bytes for a head/tail snapshot.
+    uint32_t _rxUsed(uint32_t head, uint32_t tail) const
+    {
+        if (_rxType == BUFFER_RING_FULL) return head - tail;
+        return (head >= tail) ? (head - tail) : (_rxBufferSize - (tail - head));
+    }
+
+    /// @brief Effective TX capacity in bytes (see class capacity rule).
+    uint32_t _txCapacity() const { return _isTxFreeRunning() ? _txBufferSize : (_txBufferSize - 1); }
+
+    /// @brief Effective RX capacity in bytes (see class capacity rule).
+    uint32_t _rxCapacity() const { return (_rxType == BUFFER_RING_FULL) ? _rxBufferSize : (_rxBufferSize - 1); }
+
+    /**
+     * @brief Consistent TX head/tail snapshot.
+     * @note With STREAM_USE_STD_ATOMIC the two acquire loads are enough. The volatile backend
+     *       rereads the tail until it is stable, in case the consumer ISR moved it meanwhile.
+     */
+    void _txSnapshot(uint32_t& head, uint32_t& tail) const;
+
+    /// @copydoc _txSnapshot()
+    void _rxSnapshot(uint32_t& head, uint32_t& tail) const;
+
+    /**
+     * @brief Find the first complete line in two readable segments (see readLineRx()).
+     * @return false if the segments hold no complete line.
+     */
+    static bool _findLine(const char* seg1, uint32_t len1, const char* seg2, uint32_t len2,
+                          StreamLineEnding ending, StreamLineView& line);
+
+    /// @brief Publish a new RX read position (release) and invalidate scan cursors.
+    void _rxSetTail(uint32_t tail)
+    {
+        streamStoreRelease(_rxTail, tail);
+        ++_rxReadEpoch;
+    }
+
+    /**
+     * @brief rxPeek() for the TX buffer (consumer side: up to two readable segments).
+     * @return false if the TX buffer is not configured.
+     */
+    bool _txPeek(const char*& seg1, uint32_t& len1, const char*& seg2, uint32_t& len2) const;
+
+    /**
+     * @brief Ring producer: free TX bytes, computed from the cached consumer tail.
+     * @return Free bytes; exact if fewer than dataSize (the tail is read again only in that case).
+     * @note Producer context only. Avoids a cross-core read of _txTail on every push.
+     */
+    uint32_t _txRingFree(uint32_t dataSize);
+
+    /// @copydoc _txRingFree()
+    uint32_t _rxRingFree(uint32_t dataSize);
+
+    /**
+     * @brief Ring consumer: readable TX bytes, computed from the cached producer head.
+     * @return Readable bytes; exact if fewer than dataSize (the head is read again only in that case).
+     * @note Consumer context only.
+     */
+    uint32_t _txRingAvailable(uint32_t dataSize);
+
+    /// @copydoc _txRingAvailable()
+    uint32_t _rxRingAvailable(uint32_t dataSize);
+
+    /**
+     * @brief Snapshot readable data of a bip buffer (consumer side).
+     * @param[out] index1 Start index of the first segment.
+     * @param[out] len1 Length of the first segment.
+     * @param[out] len2 Length of the second segment (always starts at index 0).
+     */
+    static void _bipSnapshot(const StreamIndex& head, const StreamIndex& tail, const StreamIndex& watermark,
+                             uint32_t& index1, uint32_t& len1, uint32_t& len2);
+
+    /// @brief Largest contiguous block writable in a bip buffer (the whole buffer when empty).
+    static uint32_t _bipFree(uint32_t head, uint32_t tail, uint32_t bufferSize);
+
+    /**
+     * @brief Find a contiguous region of dataSize bytes in a bip buffer (producer side).
+     * @param[out] start Region start index (head, or 0 when wrapping).
+     * @return false if no contiguous region is available.
+     * @note An empty buffer is restarted at index 0 (head, tail and watermark move), so a
+     *       reservation up to the buffer size succeeds whatever the previous position was.
+     */
+    static bool _bipReserve(StreamIndex& head, StreamIndex& tail, StreamIndex& watermark, uint32_t bufferSize,
+                            uint32_t dataSize, uint32_t& start);
+
+    /// @brief Publish dataSize bytes written at start (sets the watermark on wrap).
+    static void _bipPublish(StreamIndex& head, StreamIndex& watermark, uint32_t start, uint32_t dataSize);
+
+    void _txBipSnapshot(uint32_t& index1, uint32_t& len1, uint32_t& len2) const { _bipSnapshot(_txHead, _txTail, _txWatermark, index1, len1, len2); }
+    void _rxBipSnapshot(uint32_t& index1, uint32_t& len1, uint32_t& len2) const { _bipSnapshot(_rxHead, _rxTail, _rxWatermark, index1, len1, len2); }
+    bool _txBipReserve(uint32_t dataSize, uint32_t& start) { return _bipReserve(_txHead, _txTail, _txWatermark, _txBufferSize, dataSize, start); }
+    bool _rxBipReserve(uint32_t dataSize, uint32_t& start) { return _bipReserve(_rxHead, _rxTail, _rxWatermark, _rxBufferSize, dataSize, start); }
+    void _txBipPublish(uint32_t start, uint32_t dataSize) { _bipPublish(_txHead, _txWatermark, start, dataSize); }
+    void _rxBipPublish(uint32_t start, uint32_t dataSize) { _bipPublish(_rxHead, _rxWatermark, start, dataSize); }
+
+    /// @brief New bip tail after consuming dataSize bytes from a snapshot.
+    static uint32_t _bipNextTail(uint32_t index1, uint32_t len1, uint32_t len2, uint32_t dataSize);
+
+    /// @brief Linear modes: drop dataSize bytes from the front (memmove, or read offset in BUFFER_LINEAR_LAZY).
+    void _txLinearRemove(uint32_t dataSize);
+
+    /// @copydoc _txLinearRemove()
+    void _rxLinearRemove(uint32_t dataSize);
+
+    /// @brief Linear modes: compact if dataSize bytes do not fit after the current end.
+    void _txLinearMakeRoom(uint32_t dataSize);
+
+    /// @copydoc _txLinearMakeRoom()
+    void _rxLinearMakeRoom(uint32_t dataSize);
+
+    /**
+     * @brief BUFFER_RING_MPSC producer: take a writer slot, claim, copy and publish.
+     * @param spans Fragments to write (dataSize bytes in total).
+     * @param allowPartial If true, claim the part of dataSize that fits.
+     * @return Number of bytes written (0 if there is not enough free space).
+     */
+    uint32_t _txMpscPush(const StreamConstSpan* spans, uint32_t count, uint32_t dataSize, bool allowPartial);
+
+    /**
+     * @brief Total size of a fragment list.
+     * @return false if spans is null (count > 0), a non-empty fragment has null data, or the total overflows.
+     */
+    template <typename Span>
+    static bool _spansTotal(const Span* spans, uint32_t count, uint32_t& total);
+
+    /// @brief Copy fragments into up to two destination segments (stops when the segments are full).
+    static void _gatherCopy(char* seg1, uint32_t len1, char* seg2, uint32_t len2, const StreamConstSpan* spans, uint32_t count);
+
+    /// @brief Copy up to two source segments into destination spans (stops when the segments are drained).
+    static void _scatterCopy(const char* seg1, uint32_t len1, const char* seg2, uint32_t len2, const StreamSpan* spans, uint32_t count);
+
+    /// @brief BUFFER_RING_MPSC: take a free writer slot (waits while all STREAM_MPSC_MAX_WRITERS are in use).
+    uint8_t _txMpscEnter();
+
+    /**
+     * @brief BUFFER_RING_MPSC: release the writer slot and publish the head up to the oldest
+     * region that is still being copied (all claimed bytes if no other writer is active).
+     */
+    void _txMpscLeave(uint8_t slot);
+
+    /**
+     * @brief Wake the threads blocked in a wait function (host builds only).
+     * @note Called after new RX data is published or TX space is released. Without waiters it costs
+     *       one relaxed load (no fence); see STREAM_WAIT_RECHECK_MS for the race this leaves.
+     */
+    void _notifyWaiters();
+
+    #if defined(_PLATFORM_PC_)
+        /// @brief Block until ready() returns true or the timeout expires.
+        template <typename Ready>
+        bool _waitUntil(Ready ready, uint32_t timeoutMs);
+    #endif
+
+    /// @brief TX overflow policy with STREAM_OVERFLOW_AUTO and unsupported modes resolved.
+    StreamOverflowPolicy _txOverflowMode() const;
+
+    /// @copydoc _txOverflowMode()
+    StreamOverflowPolicy _rxOverflowMode() const;
+
+    /// @brief Count one TX overflow event that lost droppedBytes bytes.
+    void _txCountDrop(uint32_t droppedBytes);
+
+    /// @copydoc _txCountDrop()
+    void _rxCountDrop(uint32_t droppedBytes);
+
+    /// @brief Largest used byte count among attached RX readers.
+    uint32_t _rxReadersMaxUsed(uint32_t head) const;
+
+    /// @brief Apply the lagging reader policy so dataSize more bytes fit for all attached readers.
+    void _rxReadersMakeRoom(uint32_t dataSize);
+
+    /// @brief Detach one reader (atomic, safe against the producer). Return false if it was not attached.
+    bool _rxDetachReader(uint8_t id);
+
+    /// @brief Detach every RX reader.
+    void _detachAllRxReaders();
+
+    #if STREAM_ATOMIC_RMW
+        /// @brief Sequentially consistent load.
+        static uint32_t _atomicLoad(const StreamIndex& value);
+
+        /// @brief Sequentially consistent store.
+        static void _atomicStore(StreamIndex& value, uint32_t desired);
+
+        /// @brief Atomic add, returns the new value.
+        static uint32_t _atomicAddFetch(StreamIndex& value, uint32_t delta);
+
+        /// @brief Atomic compare-and-swap. On failure, expected is updated with the current value.
+        static bool _atomicCas(StreamIndex& value, uint32_t& expected, uint32_t desired);
+    #endif
+
+    #if STREAM_ATOMIC_IRQ_LOCK
+        /// @brief Save PRIMASK and disable interrupts (STREAM_ATOMIC_IRQ_LOCK backend). Returns the saved PRIMASK.
+        static uint32_t _irqLock();
+
+        /// @brief Restore the PRIMASK saved by _irqLock().
+        static void _irqUnlock(uint32_t primask);
+    #endif
 };
 
 
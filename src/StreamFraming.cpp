@@ -0,0 +1,582 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "StreamFraming.h"
+
+// #####################################################################################################
+// Encoder output (reserveTx() segments)
+
+namespace
+{
+
+/// @brief CRC-16/X.25 table (reflected polynomial 0x8408), see Stream_framing::hdlcFcsUpdate().
+const uint16_t kFcsTable[256] =
+{
+    0x0000, 0x1189, 0x2312, 0x329B, 0x4624, 0x57AD, 0x6536, 0x74BF,
+    0x8C48, 0x9DC1, 0xAF5A, 0xBED3, 0xCA6C, 0xDBE5, 0xE97E, 0xF8F7,
+    0x1081, 0x0108, 0x3393, 0x221A, 0x56A5, 0x472C, 0x75B7, 0x643E,
+    0x9CC9, 0x8D40, 0xBFDB, 0xAE52, 0xDAED, 0xCB64, 0xF9FF, 0xE876,
+    0x2102, 0x308B, 0x0210, 0x1399, 0x6726, 0x76AF, 0x4434, 0x55BD,
+    0xAD4A, 0xBCC3, 0x8E58, 0x9FD1, 0xEB6E, 0xFAE7, 0xC87C, 0xD9F5,
+    0x3183, 0x200A, 0x1291, 0x0318, 0x77A7, 0x662E, 0x54B5, 0x453C,
+    0xBDCB, 0xAC42, 0x9ED9, 0x8F50, 0xFBEF, 0xEA66, 0xD8FD, 0xC974,
+    0x4204, 0x538D, 0x6116, 0x709F, 0x0420, 0x15A9, 0x2732, 0x36BB,
+    0xCE4C, 0xDFC5, 0xED5E, 0xFCD7, 0x8868, 0x99E1, 0xAB7A, 0xBAF3,
+    0x5285, 0x430C, 0x7197, 0x601E, 0x14A1, 0x0528, 0x37B3, 0x263A,
+    0xDECD, 0xCF44, 0xFDDF, 0xEC56, 0x98E9, 0x8960, 0xBBFB, 0xAA72,
+    0x6306, 0x728F, 0x4014, 0x519D, 0x2522, 0x34AB, 0x0630, 0x17B9,
+    0xEF4E, 0xFEC7, 0xCC5C, 0xDDD5, 0xA96A, 0xB8E3, 0x8A78, 0x9BF1,
+    0x7387, 0x620E, 0x5095, 0x411C, 0x35A3, 0x242A, 0x16B1, 0x0738,
+    0xFFCF, 0xEE46, 0xDCDD, 0xCD54, 0xB9EB, 0xA862, 0x9AF9, 0x8B70,
+    0x8408, 0x9581, 0xA71A, 0xB693, 0xC22C, 0xD3A5, 0xE13E, 0xF0B7,
+    0x0840, 0x19C9, 0x2B52, 0x3ADB, 0x4E64, 0x5FED, 0x6D76, 0x7CFF,
+    0x9489, 0x8500, 0xB79B, 0xA612, 0xD2AD, 0xC324, 0xF1BF, 0xE036,
+    0x18C1, 0x0948, 0x3BD3, 0x2A5A, 0x5EE5, 0x4F6C, 0x7DF7, 0x6C7E,
+    0xA50A, 0xB483, 0x8618, 0x9791, 0xE32E, 0xF2A7, 0xC03C, 0xD1B5,
+    0x2942, 0x38CB, 0x0A50, 0x1BD9, 0x6F66, 0x7EEF, 0x4C74, 0x5DFD,
+    0xB58B, 0xA402, 0x9699, 0x8710, 0xF3AF, 0xE226, 0xD0BD, 0xC134,
+    0x39C3, 0x284A, 0x1AD1, 0x0B58, 0x7FE7, 0x6E6E, 0x5CF5, 0x4D7C,
+    0xC60C, 0xD785, 0xE51E, 0xF497, 0x8028, 0x91A1, 0xA33A, 0xB2B3,
+    0x4A44, 0x5BCD, 0x6956, 0x78DF, 0x0C60, 0x1DE9, 0x2F72, 0x3EFB,
+    0xD68D, 0xC704, 0xF59F, 0xE416, 0x90A9, 0x8120, 0xB3BB, 0xA232,
+    0x5AC5, 0x4B4C, 0x79D7, 0x685E, 0x1CE1, 0x0D68, 0x3FF3, 0x2E7A,
+    0xE70E, 0xF687, 0xC41C, 0xD595, 0xA12A, 0xB0A3, 0x8238, 0x93B1,
+    0x6B46, 0x7ACF, 0x4854, 0x59DD, 0x2D62, 0x3CEB, 0x0E70, 0x1FF9,
+    0xF78F, 0xE606, 0xD49D, 0xC514, 0xB1AB, 0xA022, 0x92B9, 0x8330,
+    0x7BC7, 0x6A4E, 0x58D5, 0x495C, 0x3DE3, 0x2C6A, 0x1EF1, 0x0F78
+};
+
+/// @brief Table step of the FCS.
+inline uint16_t fcsStep(uint16_t fcs, uint8_t c)
+{
+    return static_cast<uint16_t>((fcs >> 8) ^ kFcsTable[(fcs ^ c) & 0xFF]);
+}
+
+/// @brief Contiguous reservation (common case: no ring wrap inside the frame).
+struct LinearOut
+{
+    char* data;
+
+    void put(uint32_t index, char c) { data[index] = c; }
+    void copy(uint32_t index, const char* src, uint32_t size) { std::memcpy(data + index, src, size); }
+};
+
+/// @brief Reservation split at the ring end.
+struct SplitOut
+{
+    char* seg1;
+    uint32_t len1;
+    char* seg2;
+
+    void put(uint32_t index, char c)
+    {
+        if (index < len1) seg1[index] = c;
+        else seg2[index - len1] = c;
+    }
+
+    void copy(uint32_t index, const char* src, uint32_t size)
+    {
+        if (index >= len1) { std::memcpy(seg2 + (index - len1), src, size); return; }
+
+        const uint32_t part = ((len1 - index) < size) ? (len1 - index) : size;
+        std::memcpy(seg1 + index, src, part);
+        if (size > part) std::memcpy(seg2, src + part, size - part);
+    }
+};
+
+/**
+ * @brief COBS encode data into out, followed by the 0x00 delimiter.
+ * @return Encoded size including the delimiter.
+ */
+template <typename Out>
+uint32_t cobsEncode(Out out, const char* data, uint32_t dataSize)
+{
+    uint32_t pos = 0;
+
+    for (;;)
+    {
+        // One block: up to 254 non-zero bytes, copied as a run
+        uint32_t run = (dataSize < 254) ? dataSize : 254;
+        const void* zero = (run != 0) ? std::memchr(data, 0, run) : nullptr;
+        if (zero) run = static_cast<uint32_t>(static_cast<const char*>(zero) - data);
+
+        out.put(pos, static_cast<char>(run + 1));
+        if (run != 0) out.copy(pos + 1, data, run);     // data may be nullptr when empty
+        pos += run + 1;
+        data += run;
+        dataSize -= run;
+
+        if (zero)
+        {
+            // The zero is implied by the block code; a trailing zero still needs a final block
+            ++data;
+            --dataSize;
+            continue;
+        }
+
+        if (dataSize == 0) break;
+    }
+
+    out.put(pos++, '\0');
+    return pos;
+}
+
+/// @brief True for bytes SLIP has to escape.
+inline bool slipSpecial(char c)
+{
+    return (static_cast<uint8_t>(c) == Stream_framing::SLIP_END) || (static_cast<uint8_t>(c) == Stream_framing::SLIP_ESC);
+}
+
+/**
+ * @brief SLIP encode data into out, between two SLIP_END delimiters.
+ * @return Encoded size including the delimiters.
+ */
+template <typename Out>
+uint32_t slipEncode(Out out, const char* data, uint32_t dataSize)
+{
+    uint32_t pos = 0;
+    out.put(pos++, static_cast<char>(Stream_framing::SLIP_END));
+
+    uint32_t i = 0;
+    while (i < dataSize)
+    {
+        // Plain bytes up to the next special byte, copied as a run
+        uint32_t run = 0;
+        while ((i + run < dataSize) && !slipSpecial(data[i + run])) ++run;
+
+        out.copy(pos, data + i, run);
+        pos += run;
+        i += run;
+
+        if (i < dataSize)
+        {
+            const bool end = (static_cast<uint8_t>(data[i]) == Stream_framing::SLIP_END);
+            out.put(pos++, static_cast<char>(Stream_framing::SLIP_ESC));
+            out.put(pos++, static_cast<char>(end ? Stream_framing::SLIP_ESC_END : Stream_framing::SLIP_ESC_ESC));
+            ++i;
+        }
+    }
+
+    out.put(pos++, static_cast<char>(Stream_framing::SLIP_END));
+    return pos;
+}
+
+/// @brief True for bytes HDLC has to escape.
+inline bool hdlcSpecial(char c)
+{
+    return (static_cast<uint8_t>(c) == Stream_framing::HDLC_FLAG) || (static_cast<uint8_t>(c) == Stream_framing::HDLC_ESC);
+}
+
+/// @brief Write one HDLC byte, escaped if needed.
+template <typename Out>
+inline void hdlcPut(Out& out, uint32_t& pos, char c)
+{
+    if (hdlcSpecial(c))
+    {
+        out.put(pos++, static_cast<char>(Stream_framing::HDLC_ESC));
+        c = static_cast<char>(c ^ Stream_framing::HDLC_ESC_XOR);
+    }
+    out.put(pos++, c);
+}
+
+/**
+ * @brief HDLC encode data and its FCS into out, between two flags.
+ * @return Encoded size including the flags.
+ */
+template <typename Out>
+uint32_t hdlcEncode(Out out, const char* data, uint32_t dataSize)
+{
+    uint32_t pos = 0;
+    uint16_t fcs = Stream_framing::HDLC_FCS_INIT;
+    out.put(pos++, static_cast<char>(Stream_framing::HDLC_FLAG));
+
+    uint32_t i = 0;
+    while (i < dataSize)
+    {
+        // One pass: update the FCS while searching the next byte to escape
+        uint32_t run = 0;
+        while ((i + run < dataSize) && !hdlcSpecial(data[i + run]))
+        {
+            fcs = fcsStep(fcs, static_cast<uint8_t>(data[i + run]));
+            ++run;
+        }
+
+        out.copy(pos, data + i, run);
+        pos += run;
+        i += run;
+
+        if (i < dataSize)
+        {
+            fcs = fcsStep(fcs, static_cast<uint8_t>(data[i]));
+            hdlcPut(out, pos, data[i]);
+            ++i;
+        }
+    }
+
+    fcs = static_cast<uint16_t>(~fcs);
+    hdlcPut(out, pos, static_cast<char>(fcs & 0xFF));
+    hdlcPut(out, pos, static_cast<char>(fcs >> 8));
+
+    out.put(pos++, static_cast<char>(Stream_framing::HDLC_FLAG));
+    return pos;
+}
+
+}
+
+// #####################################################################################################
+// Stream_framing functions
+
+bool Stream_framing::cobsEncodeTx(Stream& stream, const char* data, uint32_t dataSize)
+{
+    if ((data == nullptr) && (dataSize != 0)) { stream.errorCode = STREAM_ERR_PARAM; return false; }
+
+    const uint32_t maxSize = cobsMaxEncodedSize(dataSize);
+    char *seg1, *seg2;
+    uint32_t len1, len2;
+    if (stream.reserveTx(maxSize, seg1, len1, seg2, len2) < maxSize)
+        return false;   // errorCode set by reserveTx()
+
+    const uint32_t size = (len1 >= maxSize) ? cobsEncode(LinearOut{seg1}, data, dataSize)
+                                            : cobsEncode(SplitOut{seg1, len1, seg2}, data, dataSize);
+    return stream.commitTx(size);
+}
+
+bool Stream_framing::slipEncodeTx(Stream& stream, const char* data, uint32_t dataSize)
+{
+    if (dataSize == 0) { stream.errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (data == nullptr) { stream.errorCode = STREAM_ERR_PARAM; return false; }
+
+    const uint32_t maxSize = slipMaxEncodedSize(dataSize);
+    char *seg1, *seg2;
+    uint32_t len1, len2;
+    if (stream.reserveTx(maxSize, seg1, len1, seg2, len2) < maxSize)
+        return false;   // errorCode set by reserveTx()
+
+    const uint32_t size = (len1 >= maxSize) ? slipEncode(LinearOut{seg1}, data, dataSize)
+                                            : slipEncode(SplitOut{seg1, len1, seg2}, data, dataSize);
+    return stream.commitTx(size);
+}
+
+uint16_t Stream_framing::hdlcFcsUpdate(uint16_t fcs, uint8_t c)
+{
+    return fcsStep(fcs, c);
+}
+
+uint16_t Stream_framing::hdlcFcs(const char* data, uint32_t dataSize)
+{
+    uint16_t fcs = HDLC_FCS_INIT;
+    for (uint32_t i = 0; i < dataSize; ++i)
+    {
+        fcs = fcsStep(fcs, static_cast<uint8_t>(data[i]));
+    }
+    return static_cast<uint16_t>(~fcs);
+}
+
+bool Stream_framing::hdlcEncodeTx(Stream& stream, const char* data, uint32_t dataSize)
+{
+    if (dataSize == 0) { stream.errorCode = STREAM_ERR_SIZE_ZERO; return false; }
+    if (data == nullptr) { stream.errorCode = STREAM_ERR_PARAM; return false; }
+
+    const uint32_t maxSize = hdlcMaxEncodedSize(dataSize);
+    char *seg1, *seg2;
+    uint32_t len1, len2;
+    if (stream.reserveTx(maxSize, seg1, len1, seg2, len2) < maxSize)
+        return false;   // errorCode set by reserveTx()
+
+    const uint32_t size = (len1 >= maxSize) ? hdlcEncode(LinearOut{seg1}, data, dataSize)
+                                            : hdlcEncode(SplitOut{seg1, len1, seg2}, data, dataSize);
+    return stream.commitTx(size);
+}
+
+// #####################################################################################################
+// StreamFrameDecoder
+
+void StreamFrameDecoder::setFrameBuffer(char* buffer, uint32_t size)
+{
+    _frame = buffer;
+    _frameCapacity = (buffer != nullptr) ? size : 0;
+    reset();
+}
+
+void StreamFrameDecoder::reset()
+{
+    _frameSize = 0;
+    _frameReady = false;
+    _discard = false;
+    _malformed = false;
+    _resetState();
+}
+
+bool StreamFrameDecoder::decode(const char* data, uint32_t size, uint32_t& used)
+{
+    errorCode = STREAM_OK;
+    used = 0;
+    if (_frame == nullptr) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    // The previous frame was handed out: start the next one
+    if (_frameReady)
+    {
+        _frameReady = false;
+        _frameSize = 0;
+    }
+
+    if ((data == nullptr) || (size == 0)) return false;
+    return _decode(data, size, used);
+}
+
+bool StreamFrameDecoder::decodeRx(Stream& stream)
+{
+    const char *seg1, *seg2;
+    uint32_t len1, len2;
+    if (!stream.rxPeek(seg1, len1, seg2, len2)) { errorCode = STREAM_ERR_PARAM; return false; }
+
+    uint32_t used = 0;
+    bool done = decode(seg1, len1, used);
+    if (!done && (errorCode == STREAM_OK) && (used == len1) && (len2 != 0))
+    {
+        uint32_t used2;
+        done = decode(seg2, len2, used2);
+        used += used2;
+    }
+
+    // One tail publication per call
+    if (used) stream.rxConsume(used);
+    return done;
+}
+
+bool StreamFrameDecoder::_endFrame()
+{
+    if (_discard)
+    {
+        if (_malformed) ++_malformedFrames;
+        else ++_overflowFrames;
+        _frameSize = 0;
+        _discard = false;
+        _malformed = false;
+        return false;
+    }
+
+    ++_frameCount;
+    _frameReady = true;
+    return true;
+}
+
+void StreamFrameDecoder::_dropFrame()
+{
+    ++_malformedFrames;
+    _frameSize = 0;
+    _discard = false;
+    _malformed = false;
+    _resetState();
+}
+
+// #####################################################################################################
+// StreamCobsDecoder
+
+void StreamCobsDecoder::_resetState()
+{
+    _code = 0;
+    _lastBlockFull = false;
+    _pendingZero = false;
+    _inFrame = false;
+}
+
+bool StreamCobsDecoder::_decode(const char* data, uint32_t size, uint32_t& used)
+{
+    uint32_t i = 0;
+
+    while (i < size)
+    {
+        if (_code == 0)
+        {
+            // Block code or frame delimiter
+            const uint8_t code = static_cast<uint8_t>(data[i++]);
+            if (code == 0)
+            {
+                if (!_inFrame) continue;        // idle delimiters between frames
+
+                const bool complete = _endFrame();
+                _resetState();
+                if (complete) { used = i; return true; }
+                continue;
+            }
+
+            if (_pendingZero) _putByte('\0');
+            _inFrame = true;
+            _lastBlockFull = (code == 0xFF);
+            _code = code - 1;
+            _pendingZero = (_code == 0) && !_lastBlockFull;
+            continue;
+        }
+
+        // Data bytes of the current block, copied as one run
+        uint32_t run = size - i;
+        if (run > _code) run = _code;
+
+        const void* zero = std::memchr(data + i, 0, run);
+        if (zero)
+        {
+            // Delimiter inside a block: the frame is truncated
+            i += static_cast<uint32_t>(static_cast<const char*>(zero) - (data + i)) + 1;
+            _dropFrame();
+            continue;
+        }
+
+        _put(data + i, run);
+        i += run;
+        _code = static_cast<uint8_t>(_code - run);
+        _pendingZero = (_code == 0) && !_lastBlockFull;
+    }
+
+    used = size;
+    return false;
+}
+
+// #####################################################################################################
+// StreamSlipDecoder
+
+void StreamSlipDecoder::_resetState()
+{
+    _escape = false;
+    _inFrame = false;
+}
+
+bool StreamSlipDecoder::_decode(const char* data, uint32_t size, uint32_t& used)
+{
+    uint32_t i = 0;
+
+    while (i < size)
+    {
+        if (_escape)
+        {
+            const uint8_t c = static_cast<uint8_t>(data[i++]);
+            _escape = false;
+
+            if (c == Stream_framing::SLIP_ESC_END) _putByte(static_cast<char>(Stream_framing::SLIP_END));
+            else if (c == Stream_framing::SLIP_ESC_ESC) _putByte(static_cast<char>(Stream_framing::SLIP_ESC));
+            else if (c == Stream_framing::SLIP_END) _dropFrame();    // the frame is over anyway
+            else _skipFrame();                                      // drop the rest of the frame
+            continue;
+        }
+
+        // Plain bytes up to the next special byte, copied as a run
+        uint32_t run = 0;
+        while ((i + run < size) && !slipSpecial(data[i + run])) ++run;
+
+        if (run)
+        {
+            _put(data + i, run);
+            _inFrame = true;
+            i += run;
+            continue;
+        }
+
+        const uint8_t c = static_cast<uint8_t>(data[i++]);
+        if (c == Stream_framing::SLIP_ESC)
+        {
+            _escape = true;
+            _inFrame = true;
+            continue;
+        }
+
+        // SLIP_END
+        if (!_inFrame) continue;        // empty frame (line noise flush)
+
+        const bool complete = _endFrame();
+        _resetState();
+        if (complete) { used = i; return true; }
+    }
+
+    used = size;
+    return false;
+}
+
+// #####################################################################################################
+// StreamHdlcDecoder
+
+void StreamHdlcDecoder::_resetState()
+{
+    _fcs = Stream_framing::HDLC_FCS_INIT;
+    _escape = false;
+    _inFrame = false;
+}
+
+bool StreamHdlcDecoder::_decode(const char* data, uint32_t size, uint32_t& used)
+{
+    uint32_t i = 0;
+
+    while (i < size)
+    {
+        if (_escape)
+        {
+            const char c = data[i++];
+            _escape = false;
+
+            if (static_cast<uint8_t>(c) == Stream_framing::HDLC_FLAG)
+            {
+                _dropFrame();       // abort sequence
+                continue;
+            }
+
+            const char plain = static_cast<char>(c ^ Stream_framing::HDLC_ESC_XOR);
+            _fcs = fcsStep(_fcs, static_cast<uint8_t>(plain));
+            _putByte(plain);
+            continue;
+        }
+
+        // One pass: update the FCS while searching the next special byte, then copy the run
+        uint32_t run = 0;
+        uint16_t fcs = _fcs;
+        while ((i + run < size) && !hdlcSpecial(data[i + run]))
+        {
+            fcs = fcsStep(fcs, static_cast<uint8_t>(data[i + run]));
+            ++run;
+        }
+
+        if (run)
+        {
+            _fcs = fcs;
+            _put(data + i, run);
+            _inFrame = true;
+            i += run;
+            continue;
+        }
+
+        const uint8_t c = static_cast<uint8_t>(data[i++]);
+        if (c == Stream_framing::HDLC_ESC)
+        {
+            _escape = true;
+            _inFrame = true;
+            continue;
+        }
+
+        // HDLC_FLAG
+        if (!_inFrame) continue;        // empty frame (back-to-back flags)
+
+        if (!_discard)
+        {
+            if (_frameSize < 2)
+            {
+                _dropFrame();           // too short to hold the FCS
+                continue;
+            }
+
+            if (_fcs != Stream_framing::HDLC_FCS_GOOD)
+            {
+                ++_badFcsFrames;
+                _frameSize = 0;
+                _resetState();
+                continue;
+            }
+
+            _frameSize -= 2;            // strip the FCS
+        }
+
+        const bool complete = _endFrame();
+        _resetState();
+        if (complete) { used = i; return true; }
+    }
+
+    used = size;
+    return false;
+}
@@ -0,0 +1,377 @@
+#pragma once
+
+/**
+ * @file StreamFraming.h
+ * @brief Packet framing layers over the Stream TX/RX buffers.
+ *
+ * Encoders write the framed packet straight into the TX buffer with reserveTx()/commitTx()
+ * (no temporary buffer, one publication per frame). Decoders consume RX bytes in place
+ * with rxPeek()/rxConsume() as they arrive and keep their state across calls, so a
+ * partially received frame is never scanned twice.
+ *
+ * Framings:
+ * - COBS (Consistent Overhead Byte Stuffing): 0x00 frame delimiter, at most 1 byte of
+ *   overhead per 254 payload bytes (Stream_framing::cobsEncodeTx(), StreamCobsDecoder).
+ * - SLIP (RFC 1055): 0xC0 frame delimiter, 0xC0/0xDB escaped with 0xDB
+ *   (Stream_framing::slipEncodeTx(), StreamSlipDecoder).
+ * - HDLC-like (RFC 1662 async framing): 0x7E flag, 0x7D escape (XOR 0x20), CRC-16/X.25
+ *   FCS computed in the stuffing pass (Stream_framing::hdlcEncodeTx(), StreamHdlcDecoder).
+ *
+ * Example:
+ * @code
+ * char frame[128];
+ * StreamCobsDecoder decoder(frame, sizeof(frame));
+ *
+ * Stream_framing::cobsEncodeTx(uart, packet, packetSize);
+ *
+ * while (decoder.decodeRx(uart))
+ * {
+ *     handlePacket(decoder.frame(), decoder.frameSize());
+ * }
+ * @endcode
+ *
+ * @note Encoders need reserveTx(), so BUFFER_RING_MPSC TX buffers are not supported.
+ *       A frame is written completely or not at all (the TX overflow policy does not apply).
+ */
+
+// ####################################################################################################
+// Include libraries:
+
+#include "Stream.h"
+
+// ###################################################################################################
+// Stream_framing namespace
+
+/**
+ * @namespace Stream_framing
+ * @brief Frame encoders that write into the TX buffer of a Stream.
+ */
+namespace Stream_framing
+{
+
+/**
+ * @brief Worst-case COBS encoded size of a payload, including the 0x00 delimiter.
+ * @param dataSize Payload size in bytes.
+ */
+inline uint32_t cobsMaxEncodedSize(uint32_t dataSize) { return dataSize + (dataSize / 254) + 2; }
+
+/**
+ * @brief COBS encode a payload directly into the TX buffer, followed by a 0x00 delimiter.
+ * @param stream Stream whose TX buffer receives the frame.
+ * @param data Payload bytes (may contain 0x00).
+ * @param dataSize Payload size (0 sends an empty frame).
+ * @return true if the whole frame was written.
+ *
+ * Reserves cobsMaxEncodedSize(dataSize) bytes and commits only the bytes used.
+ * @note - stream.errorCode be 1 if: "data is nullptr, TX buffer not configured or BUFFER_RING_MPSC"
+ * @note - stream.errorCode be 2 if: "Not enough free TX space for the worst-case frame"
+ */
+bool cobsEncodeTx(Stream& stream, const char* data, uint32_t dataSize);
+
+/// @brief SLIP special bytes (RFC 1055).
+constexpr uint8_t SLIP_END     = 0xC0;  ///< frame delimiter
+constexpr uint8_t SLIP_ESC     = 0xDB;  ///< escape
+constexpr uint8_t SLIP_ESC_END = 0xDC;  ///< escaped SLIP_END
+constexpr uint8_t SLIP_ESC_ESC = 0xDD;  ///< escaped SLIP_ESC
+
+/**
+ * @brief Worst-case SLIP encoded size of a payload, including both delimiters.
+ * @param dataSize Payload size in bytes.
+ */
+inline uint32_t slipMaxEncodedSize(uint32_t dataSize) { return (2 * dataSize) + 2; }
+
+/**
+ * @brief SLIP encode a payload directly into the TX buffer.
+ * @param stream Stream whose TX buffer receives the frame.
+ * @param data Payload bytes.
+ * @param dataSize Payload size (must not be 0: SLIP can not carry empty frames).
+ * @return true if the whole frame was written.
+ *
+ * The frame starts and ends with SLIP_END, so line noise before it is flushed as an
+ * empty frame at the receiver. Reserves slipMaxEncodedSize(dataSize) bytes and commits
+ * only the bytes used.
+ * @note - stream.errorCode be 1 if: "data is nullptr, TX buffer not configured or BUFFER_RING_MPSC"
+ * @note - stream.errorCode be 2 if: "Not enough free TX space for the worst-case frame"
+ * @note - stream.errorCode be 3 if: "dataSize is zero"
+ */
+bool slipEncodeTx(Stream& stream, const char* data, uint32_t dataSize);
+
+/// @brief HDLC special bytes (RFC 1662).
+constexpr uint8_t HDLC_FLAG     = 0x7E;     ///< frame delimiter
+constexpr uint8_t HDLC_ESC      = 0x7D;     ///< control escape
+constexpr uint8_t HDLC_ESC_XOR  = 0x20;     ///< escaped byte = byte ^ HDLC_ESC_XOR
+
+/// @brief Initial value of the FCS (CRC-16/X.25, reflected polynomial 0x8408).
+constexpr uint16_t HDLC_FCS_INIT = 0xFFFF;
+
+/// @brief FCS residue of a frame received without error (FCS computed over payload and FCS).
+constexpr uint16_t HDLC_FCS_GOOD = 0xF0B8;
+
+/**
+ * @brief Update a CRC-16/X.25 (HDLC FCS) with one byte.
+ * @param fcs Current value (start with HDLC_FCS_INIT).
+ */
+uint16_t hdlcFcsUpdate(uint16_t fcs, uint8_t c);
+
+/**
+ * @brief FCS of a payload as transmitted (complemented, sent low byte first).
+ * @param data Payload bytes.
+ * @param dataSize Payload size.
+ */
+uint16_t hdlcFcs(const char* data, uint32_t dataSize);
+
+/**
+ * @brief Worst-case HDLC encoded size of a payload (all bytes and the FCS escaped, both flags).
+ * @param dataSize Payload size in bytes.
+ */
+inline uint32_t hdlcMaxEncodedSize(uint32_t dataSize) { return (2 * (dataSize + 2)) + 2; }
+
+/**
+ * @brief HDLC encode a payload and its FCS directly into the TX buffer.
+ * @param stream Stream whose TX buffer receives the frame.
+ * @param data Payload bytes.
+ * @param dataSize Payload size (must not be 0).
+ * @return true if the whole frame was written.
+ *
+ * The FCS is updated in the same loop that searches the bytes to escape, then the
+ * unescaped runs are copied with memcpy. Reserves hdlcMaxEncodedSize(dataSize) bytes
+ * and commits only the bytes used.
+ * @note - stream.errorCode be 1 if: "data is nullptr, TX buffer not configured or BUFFER_RING_MPSC"
+ * @note - stream.errorCode be 2 if: "Not enough free TX space for the worst-case frame"
+ * @note - stream.errorCode be 3 if: "dataSize is zero"
+ */
+bool hdlcEncodeTx(Stream& stream, const char* data, uint32_t dataSize);
+
+}
+
+// ###################################################################################################
+// Decoders
+
+/**
+ * @class StreamFrameDecoder
+ * @brief Common part of the incremental frame decoders (frame buffer, statistics, RX polling).
+ *
+ * The decoded payload is written to a user-provided frame buffer (no dynamic allocation).
+ * A frame that does not fit is dropped up to its end delimiter and counted in
+ * getOverflowFrames().
+ */
+class StreamFrameDecoder
+{
+public:
+
+    /// @brief Last error code (see StreamError).
+    int8_t errorCode = STREAM_OK;
+
+    /**
+     * @brief Set the buffer that receives decoded payloads.
+     * @param buffer Frame buffer (non-owning).
+     * @param size Size of buffer, i.e. the largest payload accepted.
+     */
+    void setFrameBuffer(char* buffer, uint32_t size);
+
+    /**
+     * @brief Consume buffered RX bytes of a Stream until one frame is complete.
+     * @param stream Stream whose RX buffer is read (main RX reader).
+     * @return true if a frame is complete (see frame(), frameSize()), false if more bytes are needed.
+     *
+     * Stops right after the end of a complete frame; call it again for the next frame.
+     * The frame stays valid until the next decodeRx()/decode() call.
+     * @note - Error code be 1 if: "Frame buffer or RX buffer not configured"
+     */
+    bool decodeRx(Stream& stream);
+
+    /**
+     * @brief decodeRx() on raw bytes (e.g. a DMA block) instead of a Stream.
+     * @param data Received bytes.
+     * @param size Number of bytes in data.
+     * @param[out] used Number of bytes consumed (up to the end of the completed frame, or size).
+     * @return true if a frame is complete.
+     * @note - Error code be 1 if: "Frame buffer not configured"
+     */
+    bool decode(const char* data, uint32_t size, uint32_t& used);
+
+    /// @brief Drop the partially decoded frame.
+    void reset();
+
+    /// @brief Payload of the completed frame.
+    const char* frame() const { return _frame; }
+
+    /// @brief Payload size of the completed frame (0 while a frame is in progress).
+    uint32_t frameSize() const { return _frameReady ? _frameSize : 0; }
+
+    /// @brief Number of frames decoded since the last resetStats().
+    uint32_t getFrameCount() const { return _frameCount; }
+
+    /// @brief Number of frames dropped because they did not fit the frame buffer.
+    uint32_t getOverflowFrames() const { return _overflowFrames; }
+
+    /// @brief Number of frames dropped because of an invalid encoding.
+    uint32_t getMalformedFrames() const { return _malformedFrames; }
+
+    /// @brief Clear the frame statistics (including the framing specific ones).
+    void resetStats()
+    {
+        _frameCount = _overflowFrames = _malformedFrames = 0;
+        _resetExtraStats();
+    }
+
+protected:
+
+    StreamFrameDecoder(char* buffer, uint32_t size) : _frame(buffer), _frameCapacity((buffer != nullptr) ? size : 0) {}
+    ~StreamFrameDecoder() = default;
+
+    /**
+     * @brief Framing specific byte decoder.
+     * @param[out] used Bytes consumed, including the end delimiter of a completed frame.
+     * @return true if a frame was completed (after _endFrame() returned true).
+     */
+    virtual bool _decode(const char* data, uint32_t size, uint32_t& used) = 0;
+
+    /// @brief Reset the framing specific state to "between frames".
+    virtual void _resetState() = 0;
+
+    /// @brief Clear the framing specific statistics (called by resetStats()).
+    virtual void _resetExtraStats() {}
+
+    /// @brief Append decoded bytes to the frame (switches to discard mode if full).
+    void _put(const char* data, uint32_t size)
+    {
+        if (_discard) return;
+        if (size > (_frameCapacity - _frameSize)) { _discard = true; return; }
+        std::memcpy(_frame + _frameSize, data, size);
+        _frameSize += size;
+    }
+
+    /// @brief Append one decoded byte to the frame.
+    void _putByte(char c)
+    {
+        if (_discard) return;
+        if (_frameSize == _frameCapacity) { _discard = true; return; }
+        _frame[_frameSize++] = c;
+    }
+
+    /**
+     * @brief Close the current frame at its end delimiter.
+     * @return true if the frame is complete, false if it was dropped (overflow).
+     */
+    bool _endFrame();
+
+    /// @brief Drop the current frame as malformed at its end delimiter (already received).
+    void _dropFrame();
+
+    /// @brief Mark the current frame as malformed; the rest of it is skipped up to its end delimiter.
+    void _skipFrame()
+    {
+        _discard = true;
+        _malformed = true;
+    }
+
+    char* _frame;                   ///< user frame buffer
+    uint32_t _frameCapacity;        ///< size of _frame
+    uint32_t _frameSize = 0;        ///< decoded bytes of the current frame
+    bool _frameReady = false;       ///< _frame holds a complete frame
+    bool _discard = false;          ///< current frame is dropped, skip to its end
+    bool _malformed = false;        ///< _discard because of an invalid encoding (not an overflow)
+
+    uint32_t _frameCount = 0;
+    uint32_t _overflowFrames = 0;
+    uint32_t _malformedFrames = 0;
+};
+
+/**
+ * @class StreamCobsDecoder
+ * @brief Incremental COBS decoder (0x00 frame delimiter, see Stream_framing::cobsEncodeTx()).
+ *
+ * Repeated 0x00 bytes between frames are ignored. A 0x00 inside a block ends the frame
+ * early and counts it as malformed.
+ */
+class StreamCobsDecoder : public StreamFrameDecoder
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param buffer Frame buffer for decoded payloads (see setFrameBuffer()).
+     * @param size Size of buffer.
+     */
+    explicit StreamCobsDecoder(char* buffer = nullptr, uint32_t size = 0) : StreamFrameDecoder(buffer, size) {}
+
+protected:
+
+    bool _decode(const char* data, uint32_t size, uint32_t& used) override;
+    void _resetState() override;
+
+private:
+
+    uint8_t _code = 0;              ///< data bytes left in the current block (0: next byte is a code)
+    bool _lastBlockFull = false;    ///< current/last block had code 0xFF (no implicit 0x00 after it)
+    bool _pendingZero = false;      ///< a block ended; its 0x00 is emitted if another block follows
+    bool _inFrame = false;          ///< a code byte of the current frame was received
+};
+
+/**
+ * @class StreamSlipDecoder
+ * @brief Incremental SLIP decoder (RFC 1055, see Stream_framing::slipEncodeTx()).
+ *
+ * Empty frames (back-to-back SLIP_END) are ignored. SLIP_ESC followed by anything but
+ * SLIP_ESC_END/SLIP_ESC_ESC drops the frame as malformed. An escape split across two
+ * calls is resumed on the next call.
+ */
+class StreamSlipDecoder : public StreamFrameDecoder
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param buffer Frame buffer for decoded payloads (see setFrameBuffer()).
+     * @param size Size of buffer.
+     */
+    explicit StreamSlipDecoder(char* buffer = nullptr, uint32_t size = 0) : StreamFrameDecoder(buffer, size) {}
+
+protected:
+
+    bool _decode(const char* data, uint32_t size, uint32_t& used) override;
+    void _resetState() override;
+
+private:
+
+    bool _escape = false;           ///< last byte was SLIP_ESC
+    bool _inFrame = false;          ///< payload bytes of the current frame were received
+};
+
+/**
+ * @class StreamHdlcDecoder
+ * @brief Incremental HDLC-like decoder with FCS check (see Stream_framing::hdlcEncodeTx()).
+ *
+ * The FCS is checked while unescaping; frames with a wrong FCS are dropped and counted in
+ * getBadFcsFrames(). frameSize() excludes the FCS, but the frame buffer must have 2 spare
+ * bytes for it. Empty frames (back-to-back flags) are ignored; an abort sequence
+ * (HDLC_ESC, HDLC_FLAG) or a frame shorter than the FCS counts as malformed.
+ */
+class StreamHdlcDecoder : public StreamFrameDecoder
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param buffer Frame buffer for decoded payloads plus 2 FCS bytes (see setFrameBuffer()).
+     * @param size Size of buffer.
+     */
+    explicit StreamHdlcDecoder(char* buffer = nullptr, uint32_t size = 0) : StreamFrameDecoder(buffer, size) {}
+
+    /// @brief Number of frames dropped because of a wrong FCS.
+    uint32_t getBadFcsFrames() const { return _badFcsFrames; }
+
+protected:
+
+    bool _decode(const char* data, uint32_t size, uint32_t& used) override;
+    void _resetState() override;
+    void _resetExtraStats() override { _badFcsFrames = 0; }
+
+private:
+
+    uint16_t _fcs = Stream_framing::HDLC_FCS_INIT;  ///< FCS over the unescaped bytes so far
+    bool _escape = false;                           ///< last byte was HDLC_ESC
+    bool _inFrame = false;                          ///< bytes of the current frame were received
+    uint32_t _badFcsFrames = 0;
+};
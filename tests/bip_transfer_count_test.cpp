@@ -0,0 +1,153 @@
+/**
+ * @file bip_transfer_count_test.cpp
+ * @brief Host test: DMA transfers per frame, BUFFER_RING against BUFFER_BIP.
+ *
+ * The same frame workload (pseudo-random frame sizes, producer and consumer interleaved) goes
+ * through a TX ring and a TX bip buffer of the same size. The consumer plays a DMA engine that
+ * sends each frame with one transfer per contiguous segment (txPeekContiguous()). In the ring a
+ * frame that wraps the buffer end needs two transfers; in the bip buffer every frame must go out
+ * in exactly one. The bytes sent must be the same in both modes.
+ *
+ * A push is only allowed to fail when the frame really does not fit: in the ring when it exceeds
+ * the free space, in the bip buffer when no contiguous block of its size is left (in particular
+ * never on an empty buffer, wherever the previous frame ended).
+ *
+ * Build and run (from the repository root):
+ *   g++ -std=c++17 -O2 -Isrc tests/bip_transfer_count_test.cpp src/Stream.cpp -o bip_transfer_count_test
+ *   ./bip_transfer_count_test
+ */
+
+#include "Stream.h"
+#include <cstdlib>
+#include <deque>
+
+static const uint32_t BUFFER_SIZE = 1024;
+static const uint32_t FRAMES = 100000;
+static const uint32_t FRAME_MAX = 600;      // above half the buffer: an empty buffer must still take it
+
+struct TransferStats
+{
+    uint32_t frames = 0;
+    uint32_t transfers = 0;
+    uint32_t splitFrames = 0;       ///< frames that needed more than one transfer
+    uint32_t checksum = 0;
+    uint32_t refused = 0;           ///< pushes rejected although the frame fitted
+};
+
+static uint32_t nextRandom(uint32_t& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+/// @brief true if a frame of dataSize bytes must be accepted (queued bytes and free block read before the push).
+static bool mustFit(BufferType type, uint32_t queued, uint32_t freeBlock, uint32_t dataSize)
+{
+    // The ring keeps one byte free; an empty bip buffer offers all of it in one block
+    if (type == BUFFER_RING) return queued + dataSize <= BUFFER_SIZE - 1;
+    return (queued == 0) ? (dataSize <= BUFFER_SIZE) : (dataSize <= freeBlock);
+}
+
+static bool run(BufferType type, TransferStats& stats)
+{
+    static char buffer[BUFFER_SIZE];
+    Stream stream;
+    stream.setTxBuffer(buffer, BUFFER_SIZE, type);
+    if (stream.errorCode != STREAM_OK) { printf("setTxBuffer failed\n"); return false; }
+
+    std::deque<uint32_t> pending;   // sizes of the frames waiting in the buffer
+    uint32_t sizeRandom = 12345;    // frame sizes and bytes depend only on the frame number
+    uint32_t burstRandom = 678;
+    uint32_t pushed = 0;
+    uint32_t nextSize = 1 + nextRandom(sizeRandom) % FRAME_MAX;
+    char frame[FRAME_MAX];
+
+    while (stats.frames < FRAMES)
+    {
+        // Producer: queue frames while they fit (a few at a time)
+        uint32_t burst = 1 + nextRandom(burstRandom) % 4;
+        while (burst-- != 0 && pushed < FRAMES)
+        {
+            for (uint32_t i = 0; i < nextSize; ++i) frame[i] = static_cast<char>(pushed + i);
+            const uint32_t queued = stream.availableTx();
+            const uint32_t freeBlock = stream.freeTx();
+            if (!stream.pushBackTxBuffer(frame, nextSize))
+            {
+                if (mustFit(type, queued, freeBlock, nextSize)) ++stats.refused;
+                break;      // full: same retry in both modes
+            }
+            pending.push_back(nextSize);
+            ++pushed;
+            nextSize = 1 + nextRandom(sizeRandom) % FRAME_MAX;
+        }
+
+        // DMA: send one whole frame, one transfer per contiguous segment
+        if (pending.empty())
+        {
+            if (stats.refused != 0) return true;    // refused on an empty buffer: no progress possible
+            continue;
+        }
+        uint32_t left = pending.front();
+        pending.pop_front();
+        uint32_t transfers = 0;
+        while (left != 0)
+        {
+            const char* ptr;
+            uint32_t len;
+            if (!stream.txPeekContiguous(ptr, len) || len == 0)
+            {
+                printf("frame %u: %u bytes missing\n", stats.frames, left);
+                return false;
+            }
+            if (len > left) len = left;
+            for (uint32_t i = 0; i < len; ++i) stats.checksum = stats.checksum * 31u + static_cast<uint8_t>(ptr[i]);
+            stream.removeFrontTxBuffer(len);
+            left -= len;
+            ++transfers;
+        }
+
+        stats.transfers += transfers;
+        if (transfers > 1) ++stats.splitFrames;
+        ++stats.frames;
+    }
+    return true;
+}
+
+int main()
+{
+    TransferStats ring, bip;
+    if (!run(BUFFER_RING, ring) || !run(BUFFER_BIP, bip)) { printf("FAIL\n"); return EXIT_FAILURE; }
+
+    printf("%-10s %8s %10s %12s %8s\n", "mode", "frames", "transfers", "split frames", "refused");
+    printf("%-10s %8u %10u %12u %8u\n", "RING", ring.frames, ring.transfers, ring.splitFrames, ring.refused);
+    printf("%-10s %8u %10u %12u %8u\n", "BIP", bip.frames, bip.transfers, bip.splitFrames, bip.refused);
+
+    if (ring.refused != 0 || bip.refused != 0)
+    {
+        printf("a frame that fitted was refused\n");
+        printf("FAIL\n");
+        return EXIT_FAILURE;
+    }
+
+    if (bip.splitFrames != 0 || bip.transfers != bip.frames)
+    {
+        printf("BIP: frames were split across transfers\n");
+        printf("FAIL\n");
+        return EXIT_FAILURE;
+    }
+    if (ring.splitFrames == 0)
+    {
+        printf("RING: no frame wrapped, the workload does not exercise the buffer end\n");
+        printf("FAIL\n");
+        return EXIT_FAILURE;
+    }
+    if (ring.checksum != bip.checksum)
+    {
+        printf("sent bytes differ between the modes\n");
+        printf("FAIL\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
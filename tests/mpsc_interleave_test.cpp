@@ -0,0 +1,263 @@
+/**
+ * @file mpsc_interleave_test.cpp
+ * @brief Host test: BUFFER_RING_MPSC with 1..8 concurrent producers.
+ *
+ * Every producer pushes numbered messages of varying length (single pushBackTxBuffer() calls and
+ * two-span pushBackTxBufferV() calls). The consumer checks the TX byte stream byte for byte: each
+ * message must arrive whole (never interleaved with another producer's bytes) and every
+ * producer's messages must arrive in order, none missing.
+ *
+ * On Linux a second, deterministic check stalls producers in the middle of their copy (the source
+ * bytes sit on a PROT_NONE page; the SIGSEGV handler waits, then unprotects the page): the head
+ * must never pass a region that is still being copied, and the bytes claimed before a stalled
+ * producer must become visible as soon as their own producer finishes.
+ *
+ * Build and run (from the repository root):
+ *   g++ -std=c++17 -O2 -pthread -Isrc tests/mpsc_interleave_test.cpp src/Stream.cpp -o mpsc_interleave_test
+ *   ./mpsc_interleave_test
+ */
+
+#include "Stream.h"
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <atomic>
+
+#if defined(__linux__)
+    #include <signal.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+// Message layout: [length][producer][seq low][seq high][payload ...], length = whole message size.
+static const uint32_t MSG_HEADER = 4;
+static const uint32_t MSG_MAX = 255;
+static const uint32_t MESSAGES_PER_PRODUCER = 50000;
+
+static uint8_t payloadByte(uint32_t producer, uint32_t seq, uint32_t i)
+{
+    return static_cast<uint8_t>(producer * 31u + seq * 7u + i);
+}
+
+static uint32_t messageSize(uint32_t producer, uint32_t seq)
+{
+    return MSG_HEADER + ((producer * 13u + seq * 5u) % (MSG_MAX - MSG_HEADER + 1));
+}
+
+// Writer threads may still be stalled or blocked: report and stop without joining them.
+[[noreturn]] static void fail(const char* format, uint32_t value)
+{
+    printf(format, value);
+    printf("FAIL\n");
+    fflush(stdout);
+    std::_Exit(EXIT_FAILURE);
+}
+
+static void producer(Stream* stream, uint32_t id)
+{
+    // Every payload is a slice of this table, so producers spend their time in the push itself
+    // (claim, copy, publish), where a preempted writer can be overtaken by the others.
+    char table[2 * 256];
+    for (uint32_t j = 0; j < sizeof(table); ++j) table[j] = static_cast<char>(payloadByte(id, 0, j));
+
+    char msg[MSG_MAX];
+    for (uint32_t seq = 0; seq < MESSAGES_PER_PRODUCER; )
+    {
+        const uint32_t size = messageSize(id, seq);
+        const char* payload = &table[(seq * 7u + MSG_HEADER) & 0xFF];
+        const uint32_t payloadSize = size - MSG_HEADER;
+        const char header[MSG_HEADER] = { static_cast<char>(size), static_cast<char>(id),
+                                          static_cast<char>(seq & 0xFF), static_cast<char>(seq >> 8) };
+
+        bool ok;
+        if ((seq & 3) == 0)
+        {
+            // Whole message from one buffer
+            std::memcpy(msg, header, MSG_HEADER);
+            std::memcpy(msg + MSG_HEADER, payload, payloadSize);
+            ok = stream->pushBackTxBuffer(msg, size);
+        }
+        else
+        {
+            // Same bytes as fragments (gather path)
+            const uint32_t split = payloadSize / 2;
+            const StreamConstSpan spans[3] = { { header, MSG_HEADER }, { payload, split }, { payload + split, payloadSize - split } };
+            ok = stream->pushBackTxBufferV(spans, 3);
+        }
+
+        if (ok) ++seq;
+        else std::this_thread::yield();    // full: wait for the consumer
+    }
+}
+
+static bool runProducers(uint32_t producers)
+{
+    static char buffer[4096];
+    Stream stream;
+    stream.setTxBuffer(buffer, sizeof(buffer), BUFFER_RING_MPSC);
+    if (stream.errorCode != STREAM_OK) { printf("setTxBuffer failed\n"); return false; }
+
+    std::vector<std::thread> threads;
+    for (uint32_t id = 0; id < producers; ++id) threads.emplace_back(producer, &stream, id);
+
+    std::vector<uint32_t> nextSeq(producers, 0);
+    const uint32_t expected = producers * MESSAGES_PER_PRODUCER;
+    uint32_t received = 0;
+    uint8_t msg[MSG_MAX];
+    uint32_t have = 0;      // bytes of the current message collected so far
+    bool ok = true;
+
+    while (ok && received < expected)
+    {
+        const char* ptr;
+        uint32_t len;
+        if (!stream.txPeekContiguous(ptr, len) || len == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (uint32_t i = 0; i < len && ok; ++i)
+        {
+            msg[have++] = static_cast<uint8_t>(ptr[i]);
+            if (have < MSG_HEADER || have < msg[0]) continue;
+
+            // One whole message: check every byte
+            const uint32_t size = msg[0];
+            const uint32_t id = msg[1];
+            const uint32_t seq = msg[2] | (static_cast<uint32_t>(msg[3]) << 8);
+            if (size < MSG_HEADER || size > MSG_MAX || id >= producers)
+            {
+                printf("%u producers: corrupt header at message %u\n", producers, received);
+                ok = false;
+                break;
+            }
+            if (seq != nextSeq[id] || size != messageSize(id, seq))
+            {
+                printf("%u producers: producer %u sent seq %u, got seq %u (size %u)\n", producers, id, nextSeq[id], seq, size);
+                ok = false;
+                break;
+            }
+            for (uint32_t k = MSG_HEADER; k < size; ++k)
+            {
+                if (msg[k] != payloadByte(id, seq, k))
+                {
+                    printf("%u producers: producer %u seq %u byte %u is wrong (interleaved bytes)\n", producers, id, seq, k);
+                    ok = false;
+                    break;
+                }
+            }
+
+            ++nextSeq[id];
+            ++received;
+            have = 0;
+        }
+
+        stream.removeFrontTxBuffer(len);
+    }
+
+    if (!ok) fail("%u producers: stopping\n", producers);
+
+    for (std::thread& t : threads) t.join();
+
+    if (stream.availableTx() != 0 || have != 0)
+    {
+        printf("%u producers: %u unexpected trailing bytes\n", producers, stream.availableTx() + have);
+        return false;
+    }
+    return true;
+}
+
+#if defined(__linux__)
+// Stalled writers: each one copies from its own protected page and waits in the fault handler.
+static const int STALL_WRITERS = 2;
+static char* stallPage[STALL_WRITERS];
+static long pageSize;
+static std::atomic<int> stalled[STALL_WRITERS];
+static std::atomic<int> release[STALL_WRITERS];
+
+static void onFault(int, siginfo_t* info, void*)
+{
+    const char* addr = static_cast<const char*>(info->si_addr);
+    for (int w = 0; w < STALL_WRITERS; ++w)
+    {
+        if (addr < stallPage[w] || addr >= stallPage[w] + pageSize) continue;
+        stalled[w] = 1;
+        while (!release[w]) { }
+        mprotect(stallPage[w], pageSize, PROT_READ | PROT_WRITE);
+        return;
+    }
+    _exit(EXIT_FAILURE);    // a real crash
+}
+
+static void waitFlag(const std::atomic<int>& flag)
+{
+    while (!flag) std::this_thread::yield();
+}
+
+static bool stalledWriters()
+{
+    static char buffer[64];
+    Stream stream;
+    stream.setTxBuffer(buffer, sizeof(buffer), BUFFER_RING_MPSC);
+
+    pageSize = sysconf(_SC_PAGESIZE);
+    const char fill[STALL_WRITERS] = { 'A', 'B' };
+    for (int w = 0; w < STALL_WRITERS; ++w)
+    {
+        stallPage[w] = static_cast<char*>(mmap(nullptr, pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (stallPage[w] == MAP_FAILED) { printf("mmap failed\n"); return false; }
+        std::memset(stallPage[w], fill[w], pageSize);
+        mprotect(stallPage[w], pageSize, PROT_NONE);
+    }
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_sigaction = onFault;
+    action.sa_flags = SA_SIGINFO;
+    sigaction(SIGSEGV, &action, nullptr);
+
+    // Writer A claims [0, 4), writer B claims [4, 12); both stall in their copy.
+    std::thread writerA([&]() { stream.pushBackTxBuffer(stallPage[0], 4); });
+    waitFlag(stalled[0]);
+    std::thread writerB([&]() { stream.pushBackTxBuffer(stallPage[1], 8); });
+    waitFlag(stalled[1]);
+
+    // A third producer finishes behind both: nothing may be published yet.
+    if (!stream.pushBackTxBuffer("CCCC", 4) || stream.availableTx() != 0)
+        fail("stalled writers: %u bytes published while [0, 12) is being copied\n", stream.availableTx());
+
+    // A finishes while B is still stalled: A's bytes become visible, B's and C's do not.
+    release[0] = 1;
+    writerA.join();
+    if (stream.availableTx() != 4)
+        fail("stalled writers: %u bytes visible after the first writer finished, expected 4\n", stream.availableTx());
+
+    // B finishes last and publishes the rest.
+    release[1] = 1;
+    writerB.join();
+    char out[16];
+    if (!stream.popFrontTxBuffer(out, 16) || std::memcmp(out, "AAAABBBBBBBBCCCC", 16) != 0)
+        fail("stalled writers: wrong bytes after both writers finished (%u available)\n", stream.availableTx());
+
+    signal(SIGSEGV, SIG_DFL);
+    for (int w = 0; w < STALL_WRITERS; ++w) munmap(stallPage[w], pageSize);
+    return true;
+}
+#endif
+
+int main()
+{
+    #if defined(__linux__)
+        if (!stalledWriters()) { printf("FAIL\n"); return EXIT_FAILURE; }
+        printf("stalled writers ok\n");
+    #endif
+
+    for (uint32_t producers = 1; producers <= 8; ++producers)
+    {
+        if (!runProducers(producers)) { printf("FAIL\n"); return EXIT_FAILURE; }
+        printf("%u producers: %u messages ok\n", producers, producers * MESSAGES_PER_PRODUCER);
+    }
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}